@@ -1,59 +1,116 @@
 #include "Application.h"
 
-#include "iostream"
 #include "format"
 #include "SDL3/SDL.h"
 #include "Input/InputRouter.h"
 #include "Objects/Circle.h"
 #include <random>
 #include <algorithm>
+#include <fstream>
+#include <string_view>
 
+#include "Base/ConsoleVariable.h"
+#include "Base/FrameArena.h"
 #include "Base/TickableInterface.h"
 #include "Debugging/DebugDefinitions.h"
+#include "Debugging/DebugDraw.h"
+#include "Debugging/Logger.h"
+#include "Debugging/MemoryTracker.h"
+#include "Debugging/PhysicsRecorder.h"
+#include "Debugging/Profiler.h"
+#include "Entities/EntityStore.h"
+#include "Entities/EntitySystems.h"
+#include "Input/InputReplay.h"
+#include "Jobs/JobSystem.h"
 #include "Networking/NetHandler.h"
+#include "Physics/PhysicsSnapshot.h"
+#include "Render/TextCache.h"
 #include "SteamSDK/public/steam/steam_api.h"
 
-#define PRINT_SDL_ERROR(ErrorContext) std::cout << (ErrorContext) << std::format(": %s\n", SDL_GetError());
+#define PRINT_SDL_ERROR(ErrorContext) LOG(Error, "{}: {}", ErrorContext, SDL_GetError());
 #define SDL_FLAGS SDL_INIT_VIDEO
 
 ApplicationParams Application::sApplicationParams;
 
-void FrameTracker::pushFrameTime(const float frameTime)
+static TConsoleVariable<uint32_t> sMaxFPS("app.MaxFPS", 60, "Frames are paced to this rate on top of the present mode, 0 unlimits");
+static TConsoleVariable<bool> sDrawFPS("app.DrawFPS", true, "Draws the frame rate stats in the top right corner");
+
+#if ENABLE_MEMORY_TRACKING
+static TConsoleVariable<bool> sDrawMemoryStats("debug.DrawMemory", false, "Draws the heap allocations per memory tag, F9 writes them to MemoryReport.txt");
+#endif
+
+static float getSecondsSince(const uint64_t startCounter)
 {
-    lastFrameTime = frameTime;
-    mFrameTimes.insert(frameTime);
-    
-    mTotalFrameTime += frameTime;
-    ++mFrameCounter;
+    return static_cast<float>(SDL_GetPerformanceCounter() - startCounter) / SDL_GetPerformanceFrequency();
 }
 
-static float getFPSForFrameTimes(const std::multiset<float>& frameTimes)
+void FramePacer::setTargetFPS(const uint32_t framesPerSecond)
 {
-    float totalTime = 0.f;
-    for (const float frameTime : frameTimes)
-    {
-        totalTime += frameTime;
-    }
+    // OS sleeps can overshoot by about a scheduler quantum, the last part is spun instead.
+    constexpr uint64_t spinMicroseconds = 1500;
 
-    return frameTimes.size() / totalTime;
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+    mFrameTicks = framesPerSecond ? frequency / framesPerSecond : 0;
+    mSpinTicks = frequency * spinMicroseconds / 1000000;
+    mNextFrameDeadline = 0;
 }
 
-float FrameTracker::getCurrentFPS() const
+void FramePacer::waitForNextFrame()
 {
-    return 1 / lastFrameTime;
-}
+    if (!mFrameTicks) return;
 
-float FrameTracker::getAverageFPS() const
-{
-    return mFrameCounter / mTotalFrameTime;
+    uint64_t now = SDL_GetPerformanceCounter();
+
+    if (!mNextFrameDeadline || now >= mNextFrameDeadline + mFrameTicks)
+    {
+        // First frame or more than a frame behind, don't rush the missed frames.
+        mNextFrameDeadline = now + mFrameTicks;
+        return;
+    }
+
+    if (now < mNextFrameDeadline)
+    {
+        const uint64_t remainingTicks = mNextFrameDeadline - now;
+        if (remainingTicks > mSpinTicks)
+        {
+            const uint64_t sleepNanoseconds = (remainingTicks - mSpinTicks) * SDL_NS_PER_SECOND / SDL_GetPerformanceFrequency();
+            SDL_DelayNS(sleepNanoseconds);
+        }
+
+        while (SDL_GetPerformanceCounter() < mNextFrameDeadline)
+        {
+        }
+    }
+
+    mNextFrameDeadline += mFrameTicks;
 }
 
-float FrameTracker::getLowestPercentageFPS(float fraction) const
+void ObjectCounts::mergeMax(const ObjectCounts& other)
 {
-    fraction = std::clamp(fraction, 0.f, 1.f);
+    for (size_t phase = 0; phase < static_cast<size_t>(TickPhase::Count); ++phase)
+    {
+        tickables[phase] = std::max(tickables[phase], other.tickables[phase]);
+    }
+
+    drawables = std::max(drawables, other.drawables);
+    entities = std::max(entities, other.entities);
+
+    for (const ObjectCount& otherCount : other.gameCounts)
+    {
+        const auto it = std::ranges::find_if(gameCounts, [&otherCount](const ObjectCount& count)
+        {
+            return std::string_view(count.name) == otherCount.name;
+        });
 
-    std::multiset lows (mFrameTimes.begin(), mFrameTimes.end());
-    return getFPSForFrameTimes(lows);
+        if (it == gameCounts.end())
+        {
+            gameCounts.push_back(otherCount);
+        }
+        else
+        {
+            it->count = std::max(it->count, otherCount.count);
+        }
+    }
 }
 
 void WindowDeleter::operator()(SDL_Window* rawWindow) const
@@ -67,20 +124,69 @@ void RendererDeleter::operator()(SDL_Renderer* rawRenderer) const
 }
 
 DEFINE_DEFAULT_DELETER(NetHandler)
+DEFINE_DEFAULT_DELETER(JobSystem)
+DEFINE_DEFAULT_DELETER(EntityStore)
+DEFINE_DEFAULT_DELETER(InputReplay)
+DEFINE_DEFAULT_DELETER(TextCache)
 
-Application::Application(const ApplicationParams& params) : mInputRouter(std::make_unique<InputRouter>())
+Application::Application(const ApplicationParams& params) : mInputRouter(std::make_unique<InputRouter>()), mEntityStore(new EntityStore()), mInputReplay(new InputReplay())
 {
-    const auto [title, width, height, renderDriver, fps, bInDrawFPS] = params;
+    const auto [title, width, height, renderDriver, fps, presentMode, bInDrawFPS, workerThreadCount, bInPipelineRendering, bInDrawFrameTimeGraph, frameStatsPath,
+        bInHeadless, fixedDeltaSeconds, maxFrameCount, benchmarkReportPath, recordReplayPath, playReplayPath] = params;
+
+    // First so everything below can already log.
+    Logger::start();
 
     mWindowSize = {.x = static_cast<float>(width), .y = static_cast<float>(height)};
-    mFrameTime = fps ? 1000 / fps : 0;
-    bDrawFPS = bInDrawFPS;
+    sDrawFPS.set(bInDrawFPS);
+    sMaxFPS.set(fps);
+    bPipelineRendering = bInPipelineRendering && !bInHeadless;
+    bDrawFrameTimeGraph = bInDrawFrameTimeGraph;
+    mFrameStatsPath = frameStatsPath;
+
+    bHeadless = bInHeadless;
+    mFixedDeltaSeconds = std::max(fixedDeltaSeconds, 0.f);
+    mMaxFrameCount = maxFrameCount;
+    mBenchmarkReportPath = benchmarkReportPath;
+
+    if (playReplayPath)
+    {
+        if (!mInputReplay->startPlayback(playReplayPath))
+        {
+            LOG(Error, "Couldn't play replay {}", playReplayPath);
+        }
+    }
+    else if (recordReplayPath && !mInputReplay->startRecording(recordReplayPath))
+    {
+        LOG(Error, "Couldn't record replay to {}", recordReplayPath);
+    }
+
+    const uint32_t workerCount = workerThreadCount < 0 ? JobSystem::getDefaultWorkerCount() : static_cast<uint32_t>(workerThreadCount);
+    mJobSystem = std::unique_ptr<JobSystem, JobSystemDeleter>(new JobSystem(workerCount));
+
+    // The window size still drives chunk generation and culling, only nothing gets created for it.
+    if (bHeadless)
+    {
+        if (!SDL_Init(0))
+        {
+            PRINT_SDL_ERROR("Error initializing SDL")
+        }
+
+        mNetHandler = std::unique_ptr<NetHandler, NetHandlerDeleter>(new NetHandler());
+        return;
+    }
 
     if (!SDL_Init(SDL_FLAGS))
     {
         PRINT_SDL_ERROR("Error initializing SDL")
         return;
     }
+
+    mFramePacer.setTargetFPS(fps);
+    sMaxFPS.setOnChanged([this]()
+    {
+        mFramePacer.setTargetFPS(sMaxFPS.get());
+    });
     
     mWindow = std::unique_ptr<SDL_Window, WindowDeleter>(SDL_CreateWindow(title, width, height, 0));
 
@@ -96,6 +202,20 @@ Application::Application(const ApplicationParams& params) : mInputRouter(std::ma
     {
         PRINT_SDL_ERROR("Error creating Renderer")
     }
+    else if (!SDL_SetRenderVSync(mRenderer.get(), static_cast<int>(presentMode)))
+    {
+        PRINT_SDL_ERROR("Error setting present mode")
+
+        if (presentMode == PresentMode::AdaptiveVSync && !SDL_SetRenderVSync(mRenderer.get(), static_cast<int>(PresentMode::VSync)))
+        {
+            PRINT_SDL_ERROR("Error falling back to VSync")
+        }
+    }
+
+    if (mRenderer)
+    {
+        mTextCache = std::unique_ptr<TextCache, TextCacheDeleter>(new TextCache(mRenderer.get()));
+    }
 
     
     mNetHandler = std::unique_ptr<NetHandler, NetHandlerDeleter>(new NetHandler());
@@ -103,10 +223,16 @@ Application::Application(const ApplicationParams& params) : mInputRouter(std::ma
 
 Application::~Application()
 {
+    sMaxFPS.setOnChanged(TDelegate<void()>());
+
+    mJobSystem.reset();
+    mTextCache.reset();
     mRenderer.reset();
     mWindow.reset();
     
     SDL_Quit();
+
+    Logger::stop();
 }
 
 void Application::setGameMode(std::unique_ptr<GameMode> gameMode)
@@ -129,62 +255,139 @@ Application& Application::getApplication()
 
 void Application::run()
 {
+    PROFILE_THREAD_NAME("Main");
+
     bRunning = true;
     uint64_t now = SDL_GetPerformanceCounter();
 
-    while (!mNetHandler->initializeSteam())
+    // The game is playable offline right away, networking switches on once Steam is up. Headless runs never start it.
+    if (!bHeadless)
     {
-        if (!bRunning) return;
-        
-        const DisplayText initializeText
-        {
-            .screenPosition = {.x = 0, .y = -0.25},
-            .text = "Couldn't initialize SteamAPI.",
-            .color = {.r = 1, .g = 0, .b = 0},
-            .textScale = {.x = 4, .y = 4}
-        };
-
-        const DisplayText openSteamText
-        {
-            .screenPosition = {.x = 0, .y = 0.1},
-            .text = "Open Steam and login. Now.",
-            .color = {.r = 1, .g = 0, .b = 0},
-            .textScale = {.x = 3, .y = 3}
-        };
-
-
-        addDisplayText(initializeText);
-        addDisplayText(openSteamText);
-        
-        pollEvents();
-        drawFrame(0.f);
+        mNetHandler->beginSteamInitialization();
     }
+
+    RenderPacket* simulationPacket = &mRenderPackets[0];
+    RenderPacket* presentPacket = &mRenderPackets[1];
+    bool bHasPresentPacket = false;
     
     while (bRunning)
     {
-        mNetHandler->receiveMessages();
+        PROFILE_SCOPE("Frame");
+
+        uint64_t phaseStart = SDL_GetPerformanceCounter();
+        if (!bHeadless)
+        {
+            mNetHandler->receiveMessages();
+        }
+        mFrameTracker.addPhaseTime(FramePhase::NetReceive, getSecondsSince(phaseStart));
 
         const uint64_t last = now;
         now = SDL_GetPerformanceCounter();
-        const float deltaTime = static_cast<float>(now - last) / SDL_GetPerformanceFrequency();
+        const float frameTime = static_cast<float>(now - last) / SDL_GetPerformanceFrequency();
 
-        mFrameTracker.pushFrameTime(deltaTime);
-        
-        pollEvents();
-        tickObjects(deltaTime);
-        mNetHandler->runCallbacks();
-        drawFrame(deltaTime);
+        const bool bWasPlayingReplay = mInputReplay->isPlaying();
+        const float deltaTime = mInputReplay->beginFrame(mFixedDeltaSeconds > 0.f ? mFixedDeltaSeconds : frameTime);
 
-        if (mFrameTime)
+        if (bWasPlayingReplay && !mInputReplay->isPlaying())
         {
-            SDL_Delay(mFrameTime);
+            LOG(Info, "Replay finished after {} frames", mInputReplay->getFrameCount());
+            if (bHeadless) break;
         }
+
+        // Always the measured time, with a fixed delta that is what the stats are about.
+        mFrameTracker.pushFrameTime(frameTime);
+
+        phaseStart = SDL_GetPerformanceCounter();
+        if (!bHeadless)
+        {
+            pollEvents();
+        }
+        mInputReplay->routeFrameKeyEvents(*mInputRouter);
+        mFrameTracker.addPhaseTime(FramePhase::Input, getSecondsSince(phaseStart));
+
+        const auto simulate = [this, deltaTime, simulationPacket]()
+        {
+            const uint64_t tickStart = SDL_GetPerformanceCounter();
+            tickObjects(deltaTime);
+            extractRenderPacket(*simulationPacket, deltaTime);
+            mFrameTracker.addPhaseTime(FramePhase::Tick, getSecondsSince(tickStart));
+        };
+
+        if (bPipelineRendering)
+        {
+            // The tick may only touch the simulation, drawFrame only reads the packet of the last frame.
+            JobCounter simulationCounter;
+            mJobSystem->schedule(simulate, &simulationCounter);
+
+            if (bHasPresentPacket)
+            {
+                phaseStart = SDL_GetPerformanceCounter();
+                drawFrame(*presentPacket);
+                mFrameTracker.addPhaseTime(FramePhase::Draw, getSecondsSince(phaseStart));
+            }
+
+            mJobSystem->wait(simulationCounter);
+
+            std::swap(simulationPacket, presentPacket);
+            bHasPresentPacket = true;
+        }
+        else
+        {
+            simulate();
+
+            if (!bHeadless)
+            {
+                phaseStart = SDL_GetPerformanceCounter();
+                drawFrame(*simulationPacket);
+                mFrameTracker.addPhaseTime(FramePhase::Draw, getSecondsSince(phaseStart));
+            }
+        }
+
+        if (mBenchmarkReportPath)
+        {
+            collectObjectCounts(mObjectCounts);
+            mPeakObjectCounts.mergeMax(mObjectCounts);
+        }
+
+        if (!bHeadless)
+        {
+            phaseStart = SDL_GetPerformanceCounter();
+            {
+                PROFILE_SCOPE("NetHandler::runCallbacks");
+                mNetHandler->updateSteamInitialization();
+                mNetHandler->runCallbacks();
+            }
+            mFrameTracker.addPhaseTime(FramePhase::Callbacks, getSecondsSince(phaseStart));
+        }
+
+        // Nothing runs on the job system at this point, every thread's transient allocations are dead.
+        FrameArena::resetAll();
+        MemoryTracker::endFrame();
+
+        if (mMaxFrameCount && getFrameCount() >= mMaxFrameCount)
+        {
+            bRunning = false;
+        }
+
+        mFramePacer.waitForNextFrame();
     }
-}
 
-void Application::addDebugLine(const DebugLine& debugLine)
-{
-    mDebugLines.push_back(debugLine);
+    mInputReplay->stop();
+
+    if (mFrameStatsPath && !mFrameTracker.writeToFile(mFrameStatsPath))
+    {
+        LOG(Warning, "Couldn't write frame stats to {}", mFrameStatsPath);
+    }
+
+    if (mBenchmarkReportPath)
+    {
+        measurePhysicsSnapshot();
+
+        if (!writeBenchmarkReport(mBenchmarkReportPath))
+        {
+            LOG(Warning, "Couldn't write benchmark report to {}", mBenchmarkReportPath);
+        }
+    }
 }
 
 void Application::addDisplayText(const DisplayText& displayText)
@@ -208,99 +411,132 @@ void Application::setRenderCamera(const std::weak_ptr<Camera> inCamera)
 
 void Application::tickObjects(const float deltaSeconds) const
 {
+    PROFILE_FUNCTION();
+
     TickableInterface::bTickInProgress = true;
-    std::vector<int> destroyedTickableIndices;
 
-    const size_t tickableNum = TickableInterface::sTickables.size();
-    for (size_t i = tickableNum - 1; i < std::numeric_limits<size_t>::max(); --i)
+    const uint64_t lowPriorityBudgetTicks = static_cast<uint64_t>(TickableInterface::getLowPriorityTickBudget() * SDL_GetPerformanceFrequency());
+    uint64_t lowPrioritySpentTicks = 0;
+
+    // A budget in wall time would make which tickables tick depend on the machine, deterministic runs and replays go without.
+    const bool bBudgetLowPriority = mFixedDeltaSeconds <= 0.f && mInputReplay->getMode() == InputReplayMode::Off;
+
+    for (size_t phase = 0; phase < static_cast<size_t>(TickPhase::Count); ++phase)
     {
-        TickableInterface* tickable = TickableInterface::sTickables[i];
-        if (!tickable)
+        PROFILE_SCOPE(getTickPhaseName(static_cast<TickPhase>(phase)));
+        MEMORY_SCOPE(static_cast<TickPhase>(phase) == TickPhase::Physics ? MemoryTag::Physics : MemoryTag::Gameplay);
+
+        std::vector<TickableInterface*>& tickGroup = TickableInterface::sTickGroups[phase];
+
+        if (static_cast<TickPhase>(phase) == TickPhase::Parallel)
         {
-            destroyedTickableIndices.push_back(static_cast<int>(i));
+            tickParallelGroup(tickGroup, deltaSeconds);
+            TickableInterface::compactTickGroup(TickPhase::Parallel);
             continue;
-        }   
-        
-        tickable->tick(deltaSeconds);
-    }
+        }
 
-    for (const int i: destroyedTickableIndices)
-    {
-        TickableInterface::sTickables.erase(TickableInterface::sTickables.begin() + i);
-    }
+        // Indexed since a tickable can destroy others while ticking, which only nulls their slot.
+        for (size_t i = 0; i < tickGroup.size(); ++i)
+        {
+            TickableInterface* tickable = tickGroup[i];
+            if (!tickable || !tickable->accumulateTickDelta(deltaSeconds)) continue;
 
-    while (!TickableInterface::sTickablesCreatedInTick.empty())
-    {
-        TickableInterface::sTickables.push_back(TickableInterface::sTickablesCreatedInTick.top());
-        TickableInterface::sTickablesCreatedInTick.pop();
+            if (tickable->getTickPriority() == TickPriority::Normal)
+            {
+                tickable->tickAccumulated();
+                continue;
+            }
+
+            // Over budget only the ones that waited too long tick, the rest keep accumulating for a later frame.
+            if (bBudgetLowPriority && lowPrioritySpentTicks >= lowPriorityBudgetTicks && tickable->mAccumulatedDeltaTime < TickableInterface::getMaxLowPriorityTickDelay()) continue;
+
+            const uint64_t tickStart = SDL_GetPerformanceCounter();
+            tickable->tickAccumulated();
+            lowPrioritySpentTicks += SDL_GetPerformanceCounter() - tickStart;
+        }
+
+        TickableInterface::compactTickGroup(static_cast<TickPhase>(phase));
+
+        if (static_cast<TickPhase>(phase) == TickPhase::Physics)
+        {
+            integrateEntityBodies(*mEntityStore, deltaSeconds);
+
+#if ENABLE_PHYSICS_RECORDER
+            // Nobody can open the viewer or dump the ring in headless runs, recording would only skew the benchmark.
+            if (!bHeadless)
+            {
+                PhysicsRecorder::recordFrame(getFrameCount(), deltaSeconds);
+            }
+#endif
+        }
     }
 
-    TickableInterface::bTickInProgress = false;
-}
+    TickableInterface::addTickablesCreatedInTick();
 
-static void setRenderDrawColor(SDL_Renderer* renderer, const Color& color)
-{
-    const auto [r, g, b] = color;
-    SDL_SetRenderDrawColorFloat(renderer, r, g, b, SDL_ALPHA_OPAQUE);
+    TickableInterface::bTickInProgress = false;
 }
 
-static void drawDisplayText(const DisplayText& displayText, SDL_Renderer* renderer, Vector2 windowCenter)
+void Application::tickParallelGroup(const std::vector<TickableInterface*>& tickGroup, const float deltaSeconds) const
 {
-    auto& [screenPosition, text, color, duration, textScale, anchor] = displayText;
+    // Tiny batches cost more in scheduling than they save.
+    constexpr uint32_t minBatchSize = 32;
 
-    windowCenter /= textScale;
+    const uint32_t tickableCount = static_cast<uint32_t>(tickGroup.size());
+    const uint32_t batchSize = std::max(minBatchSize, (tickableCount + mJobSystem->getThreadCount() - 1) / mJobSystem->getThreadCount());
 
-    const Vector2 position = windowCenter + windowCenter * screenPosition;
+    mJobSystem->parallelFor(tickableCount, batchSize, [&tickGroup, deltaSeconds](const uint32_t begin, const uint32_t end)
+    {
+        MEMORY_SCOPE(MemoryTag::Gameplay);
 
-    const char* textCharPtr = text.c_str();
-    const float halfTextWidth = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE * SDL_strlen(textCharPtr) / 2;
-    const float halfTextHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE / 2;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            TickableInterface* tickable = tickGroup[i];
+            if (tickable && tickable->accumulateTickDelta(deltaSeconds))
+            {
+                tickable->tickAccumulated();
+            }
+        }
+    });
+}
 
-    const float x = position.x - halfTextWidth - anchor.x * halfTextWidth;
-    const float y = position.y - halfTextHeight - anchor.y * halfTextHeight;
-                
-    SDL_SetRenderDrawColor(renderer, color.r * 255, color.g * 255, color.b * 255, 255);
-    SDL_SetRenderScale(renderer, textScale.x, textScale.y);
-    SDL_RenderDebugText(renderer, x, y, textCharPtr);
-    SDL_SetRenderScale(renderer, 1.f, 1.f);
+static void setRenderDrawColor(SDL_Renderer* renderer, const Color& color)
+{
+    const auto [r, g, b] = color;
+    SDL_SetRenderDrawColorFloat(renderer, r, g, b, SDL_ALPHA_OPAQUE);
 }
 
-void Application::drawFrame(const float deltaTime)
+void Application::extractRenderPacket(RenderPacket& packet, const float deltaTime)
 {
-    SDL_SetRenderDrawColor(mRenderer.get(), 0, 0, 0, SDL_ALPHA_OPAQUE);
-    SDL_RenderClear(mRenderer.get());
+    PROFILE_FUNCTION();
+    MEMORY_SCOPE(MemoryTag::Rendering);
+
+    packet.reset();
 
     const Vector2 viewLocation = getCurrentViewLocation();
+    packet.viewLocation = viewLocation;
 
-    for (DrawableInterface* drawable : DrawableInterface::sDrawables)
+    DrawableInterface::compactDrawables();
+    for (const DrawableInterface* drawable : DrawableInterface::sDrawables)
     {
         if (drawable->shouldBeCulled(viewLocation, mWindowSize)) continue;
-        drawable->draw(mRenderer.get(), viewLocation);
+        drawable->appendRenderItem(packet, viewLocation);
     }
 
-#if DRAW_DEBUG_LINES
+    appendEntityRenderItems(*mEntityStore, packet, viewLocation, mWindowSize);
 
-    for (DebugLine& debugLine : mDebugLines)
-    {
-        auto& [start, end, color, duration] = debugLine;
-        duration -= deltaTime;
-
-        const Vector2 screenStart = start - viewLocation;
-        const Vector2 screenEnd = end - viewLocation;
-        setRenderDrawColor(mRenderer.get(), color);
-        SDL_RenderLine(mRenderer.get(), screenStart.x, screenStart.y, screenEnd.x, screenEnd.y);
-    }
+#if DRAW_DEBUG_LINES
+    DebugDraw::extractLines(packet.debugLines, deltaTime);
+#endif
 
-    std::erase_if(mDebugLines, [](const DebugLine& debugLine)
-    {
-        return debugLine.duration < 0.f;
-    });
+#if ENABLE_PHYSICS_RECORDER
+    PhysicsRecorder::extractViewerFrame(packet);
 #endif
 
-    
-    if (bDrawFPS)
+    if (sDrawFPS.get())
     {
-        std::string messageStr = std::format("Current FPS: {:.2f}\n Average FPS: {:.2f}\n", mFrameTracker.getCurrentFPS(), mFrameTracker.getAverageFPS());
+        const FrameTimeStats stats = mFrameTracker.getStats(FrameTimeWindow::OneSecond);
+        std::string messageStr = std::format("Current FPS: {:.2f}\n Average FPS: {:.2f}\n 1% Low FPS: {:.2f}\n P99: {:.2f} ms\n Frame arena: {:.1f} KB\n",
+            mFrameTracker.getCurrentFPS(), mFrameTracker.getAverageFPS(), mFrameTracker.getLowestPercentageFPS(0.01f), stats.p99 * 1000.f, FrameArena::getLastFrameBytes() / 1024.f);
 
         DisplayText displayText;
         displayText.text = messageStr.c_str();
@@ -310,24 +546,250 @@ void Application::drawFrame(const float deltaTime)
         addDisplayText(displayText);
     }
 
+#if ENABLE_MEMORY_TRACKING
+    if (sDrawMemoryStats.get())
+    {
+        std::string memoryStr = "Tag: allocs/frame, KB/frame, live KB, peak KB\n";
+        for (size_t tag = 0; tag < static_cast<size_t>(MemoryTag::Count); ++tag)
+        {
+            const MemoryTagStats stats = MemoryTracker::getStats(static_cast<MemoryTag>(tag));
+            memoryStr += std::format(" {}: {}, {:.1f}, {:.1f}, {:.1f}\n", getMemoryTagName(static_cast<MemoryTag>(tag)), stats.frameAllocationCount,
+                stats.frameAllocatedBytes / 1024.f, stats.liveBytes / 1024.f, stats.peakLiveBytes / 1024.f);
+        }
+
+        DisplayText displayText;
+        displayText.text = std::move(memoryStr);
+        displayText.screenPosition = {.x = -1, .y = 0};
+        displayText.alignment = {.x = -1, .y = 0};
+
+        addDisplayText(displayText);
+    }
+#endif
+
+    if (bDrawFrameTimeGraph)
+    {
+        extractFrameTimeGraph(packet);
+    }
+
+    packet.displayTexts.insert(packet.displayTexts.end(), mDisplayTexts.begin(), mDisplayTexts.end());
+
+    if (bConsoleOpen)
+    {
+        packet.displayTexts.push_back({.screenPosition = {.x = -1, .y = 1}, .text = "> " + mConsoleInput + "_", .textScale = {.x = 2, .y = 2}, .alignment = {.x = -1, .y = 1}});
+    }
+
     for (DisplayText& displayText : mDisplayTexts)
     {
         displayText.duration -= deltaTime;
-
-        drawDisplayText(displayText, mRenderer.get(), mWindowSize/2);
     }
 
     std::erase_if(mDisplayTexts, [](const DisplayText& displayText)
     {
         return displayText.duration < 0.f;
     });
+}
+
+void Application::extractFrameTimeGraph(RenderPacket& packet)
+{
+    constexpr uint32_t graphFrameCount = 300;
+    constexpr float graphHeight = 120.f;
+    constexpr float graphMaxFrameTime = 1.f / 20.f;
+    constexpr float graphMargin = 10.f;
+
+    mFrameTracker.getRecentFrameTimes(graphFrameCount, mRecentFrameTimes);
+
+    const float graphBottom = mWindowSize.y - graphMargin;
+    const float columnWidth = 2.f;
+    const float graphRight = graphMargin + columnWidth * graphFrameCount;
+
+    const auto getGraphY = [graphBottom](const float frameTime)
+    {
+        return graphBottom - std::min(frameTime / graphMaxFrameTime, 1.f) * graphHeight;
+    };
+
+    // 60 and 30 FPS reference lines, then the frame times oldest to newest
+    packet.frameTimeGraphReferences = {
+        {.x = graphMargin, .y = getGraphY(1.f / 60.f)}, {.x = graphRight, .y = getGraphY(1.f / 60.f)},
+        {.x = graphMargin, .y = getGraphY(1.f / 30.f)}, {.x = graphRight, .y = getGraphY(1.f / 30.f)}
+    };
+
+    const float graphLeft = graphRight - columnWidth * mRecentFrameTimes.size();
+    for (size_t i = 0; i < mRecentFrameTimes.size(); ++i)
+    {
+        packet.frameTimeGraph.push_back({.x = graphLeft + columnWidth * i, .y = getGraphY(mRecentFrameTimes[i])});
+    }
+}
+
+void Application::collectObjectCounts(ObjectCounts& outCounts) const
+{
+    for (size_t phase = 0; phase < static_cast<size_t>(TickPhase::Count); ++phase)
+    {
+        outCounts.tickables[phase] = static_cast<uint32_t>(TickableInterface::sTickGroups[phase].size());
+    }
+
+    outCounts.drawables = static_cast<uint32_t>(DrawableInterface::sDrawables.size());
+    outCounts.entities = mEntityStore->getEntityCount();
+
+    outCounts.gameCounts.clear();
+    if (mGameMode)
+    {
+        mGameMode->appendObjectCounts(outCounts.gameCounts);
+    }
+}
+
+void Application::measurePhysicsSnapshot()
+{
+    constexpr uint32_t iterationCount = 100;
+
+    PhysicsSnapshot snapshot;
+
+    // Warms the buffers, the timed runs shouldn't include their growth.
+    snapshot.capture();
+    snapshot.restore();
+
+    uint64_t captureTicks = 0;
+    uint64_t restoreTicks = 0;
+    for (uint32_t i = 0; i < iterationCount; ++i)
+    {
+        const uint64_t captureStart = SDL_GetPerformanceCounter();
+        snapshot.capture();
+        const uint64_t restoreStart = SDL_GetPerformanceCounter();
+        snapshot.restore();
+        const uint64_t restoreEnd = SDL_GetPerformanceCounter();
+
+        captureTicks += restoreStart - captureStart;
+        restoreTicks += restoreEnd - restoreStart;
+    }
+
+    const double tickSeconds = 1.0 / static_cast<double>(SDL_GetPerformanceFrequency()) / iterationCount;
+    mSnapshotBodyCount = static_cast<uint32_t>(snapshot.getBodyCount());
+    mSnapshotCaptureSeconds = static_cast<float>(captureTicks * tickSeconds);
+    mSnapshotRestoreSeconds = static_cast<float>(restoreTicks * tickSeconds);
+}
+
+bool Application::writeBenchmarkReport(const char* path) const
+{
+    std::ofstream file(path);
+    if (!file) return false;
+
+    const FrameTimeStats stats = mFrameTracker.getBufferedStats();
+
+    file << std::format("{{\n  \"frameCount\": {},\n  \"bufferedFrameCount\": {},\n  \"headless\": {},\n  \"fixedDeltaSeconds\": {:.6f},\n  \"workerThreads\": {},\n",
+        getFrameCount(), stats.sampleCount, bHeadless, mFixedDeltaSeconds, mJobSystem->getThreadCount());
+
+    file << std::format("  \"frameMs\": {{ \"average\": {:.4f}, \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}, \"onePercentLow\": {:.4f} }},\n",
+        stats.average * 1000.f, stats.p50 * 1000.f, stats.p95 * 1000.f, stats.p99 * 1000.f, stats.onePercentLow * 1000.f);
+
+    file << "  \"phasesMs\": {";
+    for (size_t phase = 0; phase < static_cast<size_t>(FramePhase::Count); ++phase)
+    {
+        file << std::format("{} \"{}\": {:.4f}", phase ? "," : "", getFramePhaseName(static_cast<FramePhase>(phase)), stats.phaseAverages[phase] * 1000.f);
+    }
+    file << " },\n";
+
+    const auto writeObjectCounts = [&file](const char* name, const ObjectCounts& counts, const bool bLast)
+    {
+        file << std::format("  \"{}\": {{ \"tickables\": {{", name);
+        for (size_t phase = 0; phase < static_cast<size_t>(TickPhase::Count); ++phase)
+        {
+            file << std::format("{} \"{}\": {}", phase ? "," : "", getTickPhaseName(static_cast<TickPhase>(phase)), counts.tickables[phase]);
+        }
+
+        file << std::format(" }}, \"drawables\": {}, \"entities\": {}", counts.drawables, counts.entities);
+        for (const ObjectCount& gameCount : counts.gameCounts)
+        {
+            file << std::format(", \"{}\": {}", gameCount.name, gameCount.count);
+        }
+
+        file << (bLast ? " }\n" : " },\n");
+    };
+
+    // Scaled linearly to the 1,000 body target of 50 microseconds for a capture and a restore.
+    const float snapshotMicroseconds = (mSnapshotCaptureSeconds + mSnapshotRestoreSeconds) * 1e6f;
+    const float snapshotMicrosecondsPer1000Bodies = mSnapshotBodyCount ? snapshotMicroseconds * 1000.f / mSnapshotBodyCount : 0.f;
+    file << std::format("  \"physicsSnapshot\": {{ \"bodies\": {}, \"captureUs\": {:.3f}, \"restoreUs\": {:.3f}, \"usPer1000Bodies\": {:.3f}, \"withinTarget\": {} }},\n",
+        mSnapshotBodyCount, mSnapshotCaptureSeconds * 1e6f, mSnapshotRestoreSeconds * 1e6f, snapshotMicrosecondsPer1000Bodies, snapshotMicrosecondsPer1000Bodies < 50.f);
+
+    writeObjectCounts("finalObjectCounts", mObjectCounts, false);
+    writeObjectCounts("peakObjectCounts", mPeakObjectCounts, true);
+
+    file << "}\n";
+
+    return static_cast<bool>(file);
+}
+
+void Application::drawFrame(const RenderPacket& packet)
+{
+    PROFILE_FUNCTION();
+    MEMORY_SCOPE(MemoryTag::Rendering);
+
+    SDL_Renderer* renderer = mRenderer.get();
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+
+    for (const RenderItem& item : packet.items)
+    {
+        const auto [r, g, b] = item.color;
+        const Vector2& screenLocation = item.screenLocation;
+
+        switch (item.type)
+        {
+        case RenderItemType::FilledRect:
+            {
+                setRenderDrawColor(renderer, item.color);
+                const SDL_FRect positionedRect = {screenLocation.x, screenLocation.y, item.size.x, item.size.y};
+                SDL_RenderFillRect(renderer, &positionedRect);
+            }
+            break;
+        case RenderItemType::Geometry:
+            {
+                if (!item.mesh) break;
+
+                mTranslatedVertices.assign(item.mesh->vertices.begin(), item.mesh->vertices.end());
+                for (SDL_Vertex& vertex : mTranslatedVertices)
+                {
+                    vertex.color = {r, g, b, 0};
+                    vertex.position.x += screenLocation.x;
+                    vertex.position.y += screenLocation.y;
+                }
+
+                const std::vector<int>& indices = item.mesh->indices;
+                SDL_RenderGeometry(renderer, nullptr, mTranslatedVertices.data(), static_cast<int>(mTranslatedVertices.size()), indices.data(), static_cast<int>(indices.size()));
+            }
+            break;
+        default: ;
+        }
+    }
+
+    DebugDraw::drawLines(renderer, packet.debugLines, packet.viewLocation);
 
+    if (!packet.frameTimeGraph.empty())
+    {
+        SDL_SetRenderDrawColor(renderer, 90, 90, 90, SDL_ALPHA_OPAQUE);
+        for (size_t i = 0; i + 1 < packet.frameTimeGraphReferences.size(); i += 2)
+        {
+            const SDL_FPoint& start = packet.frameTimeGraphReferences[i];
+            const SDL_FPoint& end = packet.frameTimeGraphReferences[i + 1];
+            SDL_RenderLine(renderer, start.x, start.y, end.x, end.y);
+        }
+
+        SDL_SetRenderDrawColor(renderer, 0, 255, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderLines(renderer, packet.frameTimeGraph.data(), static_cast<int>(packet.frameTimeGraph.size()));
+    }
+
+    if (mTextCache)
+    {
+        mTextCache->drawTexts(packet.displayTexts, mWindowSize);
+    }
     
-    SDL_RenderPresent(mRenderer.get());
+    SDL_RenderPresent(renderer);
 }
 
 void Application::pollEvents()
 {
+    PROFILE_FUNCTION();
+
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
@@ -348,9 +810,151 @@ void Application::handleEvent(const SDL_Event& event)
             const SDL_Scancode scancode = event.key.scancode;
             const bool bPressed = SDL_EVENT_KEY_DOWN == eventType;
 
-            mInputRouter->routeKeyEvent(scancode, bPressed);
+#if ENABLE_MEMORY_TRACKING
+            if (scancode == SDL_SCANCODE_F9 && bPressed && !event.key.repeat)
+            {
+                constexpr const char* reportPath = "MemoryReport.txt";
+                if (!MemoryTracker::writeReport(reportPath))
+                {
+                    LOG(Warning, "Couldn't write memory report to {}", reportPath);
+                }
+            }
+#endif
+
+#if ENABLE_PHYSICS_RECORDER
+            if (scancode == SDL_SCANCODE_F6 && bPressed && !event.key.repeat)
+            {
+                constexpr const char* recordingPath = "PhysicsRecording.csv";
+                if (PhysicsRecorder::writeToFile(recordingPath))
+                {
+                    LOG(Info, "Wrote {} physics frames to {}", PhysicsRecorder::getFrameCount(), recordingPath);
+                }
+                else
+                {
+                    LOG(Warning, "Couldn't write physics recording to {}", recordingPath);
+                }
+            }
+
+            if (scancode == SDL_SCANCODE_F7 && bPressed && !event.key.repeat)
+            {
+                PhysicsRecorder::setViewing(!PhysicsRecorder::isViewing());
+                break;
+            }
+
+            // Holding an arrow keeps scrubbing, the game doesn't see the presses while the viewer is open.
+            if (PhysicsRecorder::isViewing() && bPressed && (scancode == SDL_SCANCODE_LEFT || scancode == SDL_SCANCODE_RIGHT))
+            {
+                const int32_t step = event.key.mod & SDL_KMOD_SHIFT ? 10 : 1;
+                PhysicsRecorder::scrub(scancode == SDL_SCANCODE_LEFT ? -step : step);
+                break;
+            }
+#endif
+
+#if ENABLE_PROFILER
+            if (scancode == SDL_SCANCODE_F10 && bPressed && !event.key.repeat)
+            {
+                toggleProfilerCapture();
+            }
+#endif
+
+            if (scancode == SDL_SCANCODE_GRAVE && bPressed && !event.key.repeat)
+            {
+                setConsoleOpen(!bConsoleOpen);
+                break;
+            }
+
+            if (bConsoleOpen && bPressed)
+            {
+                handleConsoleKeyPressed(scancode);
+                break;
+            }
+
+            // While a replay plays only its own key events reach the game. Releases still pass an open console so no key stays held.
+            if (!mInputReplay->isPlaying())
+            {
+                mInputRouter->routeKeyEvent(scancode, bPressed);
+            }
+        }
+        break;
+    case SDL_EVENT_TEXT_INPUT:
+        if (bConsoleOpen)
+        {
+            for (const char* character = event.text.text; *character; ++character)
+            {
+                // The toggle key types itself when the console opens.
+                if (*character == '`' || *character == '~') continue;
+                mConsoleInput.push_back(*character);
+            }
+        }
+        break;
+    case SDL_EVENT_RENDER_TARGETS_RESET:
+        // The atlas contents are lost, every string has to be rasterized again.
+        if (mTextCache)
+        {
+            mTextCache->clear();
+        }
+        break;
+    case SDL_EVENT_RENDER_DEVICE_RESET:
+        // The atlas texture itself is gone with the device.
+        if (mRenderer)
+        {
+            mTextCache = std::unique_ptr<TextCache, TextCacheDeleter>(new TextCache(mRenderer.get()));
+        }
+        break;
+    default: ;
+    }
+}
+
+void Application::setConsoleOpen(const bool bOpen)
+{
+    bConsoleOpen = bOpen;
+    mConsoleInput.clear();
+
+    if (bOpen)
+    {
+        SDL_StartTextInput(mWindow.get());
+    }
+    else
+    {
+        SDL_StopTextInput(mWindow.get());
+    }
+}
+
+void Application::handleConsoleKeyPressed(const SDL_Scancode scancode)
+{
+    switch (scancode)
+    {
+    case SDL_SCANCODE_RETURN:
+    case SDL_SCANCODE_KP_ENTER:
+        ConsoleVariable::execute(mConsoleInput);
+        mConsoleInput.clear();
+        break;
+    case SDL_SCANCODE_BACKSPACE:
+        if (!mConsoleInput.empty())
+        {
+            mConsoleInput.pop_back();
         }
         break;
+    case SDL_SCANCODE_ESCAPE:
+        setConsoleOpen(false);
+        break;
     default: ;
     }
-}
\ No newline at end of file
+}
+
+void Application::toggleProfilerCapture()
+{
+    constexpr const char* tracePath = "ProfileTrace.json";
+
+    if (!Profiler::isCapturing())
+    {
+        Profiler::startCapture();
+        return;
+    }
+
+    Profiler::stopCapture();
+    if (!Profiler::writeTrace(tracePath))
+    {
+        LOG(Warning, "Couldn't write profile trace to {}", tracePath);
+    }
+}
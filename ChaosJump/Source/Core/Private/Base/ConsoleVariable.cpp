@@ -0,0 +1,124 @@
+#include "Base/ConsoleVariable.h"
+
+#include <cctype>
+#include <fstream>
+
+#include "Debugging/Logger.h"
+
+static bool equalsIgnoreCase(const std::string_view a, const std::string_view b)
+{
+    if (a.size() != b.size()) return false;
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+    }
+
+    return true;
+}
+
+static std::string_view trim(std::string_view text)
+{
+    constexpr std::string_view whitespace = " \t\r\n";
+
+    const size_t first = text.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) return {};
+
+    return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+}
+
+ConsoleVariable*& ConsoleVariable::getHead()
+{
+    static ConsoleVariable* head = nullptr;
+    return head;
+}
+
+ConsoleVariable::ConsoleVariable(const char* name, const char* description) : mName(name), mDescription(description)
+{
+    ConsoleVariable*& head = getHead();
+    mNext = head;
+    head = this;
+}
+
+void ConsoleVariable::notifyChanged() const
+{
+    if (mOnChanged)
+    {
+        mOnChanged();
+    }
+}
+
+bool ConsoleVariable::setFromString(const std::string_view text)
+{
+    if (!parseValue(trim(text)))
+    {
+        LOG(Warning, "{} can't be set to '{}'", mName, text);
+        return false;
+    }
+
+    return true;
+}
+
+ConsoleVariable* ConsoleVariable::find(const std::string_view name)
+{
+    for (ConsoleVariable* variable = getHead(); variable; variable = variable->mNext)
+    {
+        if (equalsIgnoreCase(variable->mName, name)) return variable;
+    }
+
+    return nullptr;
+}
+
+bool ConsoleVariable::execute(std::string_view command)
+{
+    command = trim(command);
+    if (command.empty()) return false;
+
+    if (equalsIgnoreCase(command, "cvars"))
+    {
+        for (const ConsoleVariable* variable = getHead(); variable; variable = variable->mNext)
+        {
+            LOG(Info, "{} = {}  {}", variable->mName, variable->getValueString(), variable->mDescription);
+        }
+        return true;
+    }
+
+    const size_t separator = command.find_first_of(" \t=");
+    const std::string_view name = command.substr(0, separator);
+
+    ConsoleVariable* variable = find(name);
+    if (!variable)
+    {
+        LOG(Warning, "Unknown console variable {}", name);
+        return false;
+    }
+
+    if (separator == std::string_view::npos)
+    {
+        LOG(Info, "{} = {}  {}", variable->mName, variable->getValueString(), variable->mDescription);
+        return true;
+    }
+
+    const std::string_view value = trim(command.substr(separator + 1));
+    if (!variable->setFromString(value)) return false;
+
+    LOG(Info, "{} = {}", variable->mName, variable->getValueString());
+    return true;
+}
+
+bool ConsoleVariable::executeConfigFile(const char* path)
+{
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const std::string_view command = trim(line);
+        if (command.empty() || command.front() == '#') continue;
+
+        execute(command);
+    }
+
+    return true;
+}
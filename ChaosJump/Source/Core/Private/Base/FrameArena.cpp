@@ -0,0 +1,95 @@
+#include "Base/FrameArena.h"
+
+#include <algorithm>
+#include <mutex>
+
+std::atomic<size_t> FrameArena::sLastFrameBytes = 0;
+
+static std::mutex sArenasMutex;
+static std::vector<FrameArena*> sArenas;
+
+FrameArena::FrameArena()
+{
+    registerArena();
+}
+
+FrameArena::~FrameArena()
+{
+    unregisterArena();
+}
+
+void FrameArena::registerArena()
+{
+    std::lock_guard lock(sArenasMutex);
+    sArenas.push_back(this);
+}
+
+void FrameArena::unregisterArena()
+{
+    std::lock_guard lock(sArenasMutex);
+    std::erase(sArenas, this);
+}
+
+FrameArena& FrameArena::get()
+{
+    thread_local FrameArena arena;
+    return arena;
+}
+
+static size_t getAlignmentPadding(const std::byte* address, const size_t alignment)
+{
+    return (alignment - reinterpret_cast<uintptr_t>(address) % alignment) % alignment;
+}
+
+void* FrameArena::allocate(const size_t bytes, const size_t alignment)
+{
+    mAllocatedBytes += bytes;
+
+    while (mBlockIndex < mBlocks.size())
+    {
+        Block& block = mBlocks[mBlockIndex];
+
+        std::byte* address = block.memory.get() + mBlockOffset;
+        const size_t alignedOffset = mBlockOffset + getAlignmentPadding(address, alignment);
+        if (alignedOffset + bytes <= block.size)
+        {
+            mBlockOffset = alignedOffset + bytes;
+            return block.memory.get() + alignedOffset;
+        }
+
+        ++mBlockIndex;
+        mBlockOffset = 0;
+    }
+
+    // Oversized requests get a block of their own, it is reused like any other after the reset.
+    const size_t blockSize = std::max(sBlockSize, bytes + alignment);
+    mBlocks.push_back({.memory = std::make_unique_for_overwrite<std::byte[]>(blockSize), .size = blockSize});
+    mBlockIndex = mBlocks.size() - 1;
+
+    std::byte* memory = mBlocks.back().memory.get();
+    const size_t alignedOffset = getAlignmentPadding(memory, alignment);
+    mBlockOffset = alignedOffset + bytes;
+
+    return memory + alignedOffset;
+}
+
+void FrameArena::reset()
+{
+    mBlockIndex = 0;
+    mBlockOffset = 0;
+    mAllocatedBytes = 0;
+}
+
+void FrameArena::resetAll()
+{
+    std::lock_guard lock(sArenasMutex);
+
+    size_t frameBytes = 0;
+    for (FrameArena* arena : sArenas)
+    {
+        frameBytes += arena->mAllocatedBytes;
+        arena->reset();
+    }
+
+    sLastFrameBytes.store(frameBytes, std::memory_order_relaxed);
+}
@@ -0,0 +1,122 @@
+#include "Base/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const char* path)
+{
+    close();
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    mFileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    mMappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mMappingHandle)
+    {
+        close();
+        return false;
+    }
+
+    mData = static_cast<const std::byte*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!mData)
+    {
+        close();
+        return false;
+    }
+
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+    }
+
+    if (mMappingHandle)
+    {
+        CloseHandle(mMappingHandle);
+    }
+
+    if (mFileHandle)
+    {
+        CloseHandle(mFileHandle);
+    }
+
+    mData = nullptr;
+    mSize = 0;
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const char* path)
+{
+    close();
+
+    mFileDescriptor = ::open(path, O_RDONLY);
+    if (mFileDescriptor < 0) return false;
+
+    struct stat fileStats;
+    if (fstat(mFileDescriptor, &fileStats) != 0 || fileStats.st_size == 0)
+    {
+        close();
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStats.st_size), PROT_READ, MAP_PRIVATE, mFileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+
+    mData = static_cast<const std::byte*>(data);
+    mSize = static_cast<size_t>(fileStats.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mData)
+    {
+        munmap(const_cast<std::byte*>(mData), mSize);
+    }
+
+    if (mFileDescriptor >= 0)
+    {
+        ::close(mFileDescriptor);
+    }
+
+    mData = nullptr;
+    mSize = 0;
+    mFileDescriptor = -1;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "Base/ObjectPool.h"
+
+#include <algorithm>
+
+#include "Debugging/DebugDefinitions.h"
+
+void ObjectPool::BlockDeleter::operator()(std::byte* block) const
+{
+    ::operator delete(block);
+}
+
+ObjectPool::ObjectPool(const size_t slotSize, const uint32_t slotsPerBlock) : mSlotSize(std::max(slotSize, sizeof(FreeSlot))), mSlotsPerBlock(std::max(slotsPerBlock, 1u))
+{
+    // Keeps every slot aligned when they are laid out back to back.
+    constexpr size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    mSlotSize = (mSlotSize + alignment - 1) / alignment * alignment;
+}
+
+ObjectPool::~ObjectPool()
+{
+    // Objects still alive at this point would point into freed blocks.
+    ensure(mLiveCount == 0);
+}
+
+void ObjectPool::addBlock()
+{
+    std::byte* block = static_cast<std::byte*>(::operator new(mSlotSize * mSlotsPerBlock));
+    mBlocks.emplace_back(block);
+
+    // Linked back to front so slots are handed out in address order.
+    for (uint32_t i = mSlotsPerBlock; i > 0; --i)
+    {
+        FreeSlot* freeSlot = reinterpret_cast<FreeSlot*>(block + (i - 1) * mSlotSize);
+        freeSlot->next = mFreeList;
+        mFreeList = freeSlot;
+    }
+}
+
+void* ObjectPool::allocate()
+{
+    if (!mFreeList)
+    {
+        addBlock();
+    }
+
+    FreeSlot* slot = mFreeList;
+    mFreeList = slot->next;
+
+    ++mLiveCount;
+    mPeakLiveCount = std::max(mPeakLiveCount, mLiveCount);
+
+    return slot;
+}
+
+void ObjectPool::release(void* slot)
+{
+    if (!slot) return;
+
+    FreeSlot* freeSlot = static_cast<FreeSlot*>(slot);
+    freeSlot->next = mFreeList;
+    mFreeList = freeSlot;
+
+    --mLiveCount;
+}
+
+ObjectPoolStats ObjectPool::getStats() const
+{
+    return {
+        .slotSize = mSlotSize,
+        .capacity = static_cast<uint32_t>(mBlocks.size()) * mSlotsPerBlock,
+        .liveCount = mLiveCount,
+        .peakLiveCount = mPeakLiveCount,
+        .blockCount = static_cast<uint32_t>(mBlocks.size())
+    };
+}
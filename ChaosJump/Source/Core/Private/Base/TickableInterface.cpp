@@ -1,28 +1,136 @@
 ﻿#include "Base/TickableInterface.h"
 
+#include <algorithm>
+
 #include "Application.h"
 
-std::stack<TickableInterface*> TickableInterface::sTickablesCreatedInTick = {};
-std::vector<TickableInterface*> TickableInterface::sTickables = {};
+std::mutex TickableInterface::sTickablesCreatedInTickMutex;
+std::vector<TickableInterface*> TickableInterface::sTickablesCreatedInTick = {};
+std::vector<TickableInterface*> TickableInterface::sTickGroups[static_cast<size_t>(TickPhase::Count)] = {};
+std::atomic<bool> TickableInterface::sTickGroupHasHoles[static_cast<size_t>(TickPhase::Count)] = {};
 bool TickableInterface::bTickInProgress = false;
+float TickableInterface::sLowPriorityTickBudget = 0.002f;
+float TickableInterface::sMaxLowPriorityTickDelay = 0.25f;
+
+const char* getTickPhaseName(const TickPhase phase)
+{
+    switch (phase)
+    {
+    case TickPhase::PrePhysics:
+        return "PrePhysics";
+    case TickPhase::Parallel:
+        return "Parallel";
+    case TickPhase::Physics:
+        return "Physics";
+    case TickPhase::PostPhysics:
+        return "PostPhysics";
+    case TickPhase::Late:
+        return "Late";
+    default:
+        return "Unknown";
+    }
+}
 
-TickableInterface::TickableInterface()
+TickableInterface::TickableInterface(const TickPhase tickPhase) : mTickPhase(tickPhase)
 {
     if (bTickInProgress)
     {
-        sTickablesCreatedInTick.push(this);
+        std::lock_guard lock(sTickablesCreatedInTickMutex);
+        sTickablesCreatedInTick.push_back(this);
     }
     else
     {
-        sTickables.push_back(this);
+        addToTickGroup(this);
     }
 }
 
 TickableInterface::~TickableInterface()
 {
-    const auto it = std::ranges::find(sTickables, this);
-    if (it != sTickables.end())
+    if (mTickIndex == UINT32_MAX)
+    {
+        // Created and destroyed within the same tick
+        std::lock_guard lock(sTickablesCreatedInTickMutex);
+        std::erase(sTickablesCreatedInTick, this);
+        return;
+    }
+
+    const size_t phase = static_cast<size_t>(mTickPhase);
+    sTickGroups[phase][mTickIndex] = nullptr;
+    sTickGroupHasHoles[phase].store(true, std::memory_order_relaxed);
+}
+
+void TickableInterface::addToTickGroup(TickableInterface* tickable)
+{
+    std::vector<TickableInterface*>& tickGroup = sTickGroups[static_cast<size_t>(tickable->mTickPhase)];
+
+    tickable->mTickIndex = static_cast<uint32_t>(tickGroup.size());
+    tickGroup.push_back(tickable);
+}
+
+void TickableInterface::compactTickGroup(const TickPhase phase)
+{
+    if (!sTickGroupHasHoles[static_cast<size_t>(phase)].load(std::memory_order_relaxed)) return;
+
+    std::vector<TickableInterface*>& tickGroup = sTickGroups[static_cast<size_t>(phase)];
+
+    uint32_t writeIndex = 0;
+    for (TickableInterface* tickable : tickGroup)
+    {
+        if (!tickable) continue;
+
+        tickable->mTickIndex = writeIndex;
+        tickGroup[writeIndex++] = tickable;
+    }
+
+    tickGroup.resize(writeIndex);
+    sTickGroupHasHoles[static_cast<size_t>(phase)].store(false, std::memory_order_relaxed);
+}
+
+void TickableInterface::addTickablesCreatedInTick()
+{
+    std::lock_guard lock(sTickablesCreatedInTickMutex);
+
+    for (TickableInterface* tickable : sTickablesCreatedInTick)
     {
-        *it = nullptr;
+        addToTickGroup(tickable);
     }
-}
\ No newline at end of file
+
+    sTickablesCreatedInTick.clear();
+}
+
+bool TickableInterface::accumulateTickDelta(const float deltaTime)
+{
+    mAccumulatedDeltaTime += deltaTime;
+    ++mAccumulatedFrames;
+
+    return mAccumulatedFrames >= mTickFrameInterval && mAccumulatedDeltaTime >= mTickInterval;
+}
+
+void TickableInterface::tickAccumulated()
+{
+    const float deltaTime = mAccumulatedDeltaTime;
+    mAccumulatedDeltaTime = 0.f;
+    mAccumulatedFrames = 0;
+
+    tick(deltaTime);
+}
+
+void TickableInterface::setTickPriority(const TickPriority tickPriority)
+{
+    mTickPriority = tickPriority;
+}
+
+void TickableInterface::setTickInterval(const float seconds)
+{
+    mTickInterval = std::max(seconds, 0.f);
+}
+
+void TickableInterface::setTickFrameInterval(const uint32_t frames)
+{
+    mTickFrameInterval = std::max(frames, 1u);
+}
+
+void TickableInterface::setLowPriorityTickBudget(const float seconds)
+{
+    sLowPriorityTickBudget = std::max(seconds, 0.f);
+}
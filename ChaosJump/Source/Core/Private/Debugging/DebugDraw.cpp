@@ -0,0 +1,99 @@
+#include "Debugging/DebugDraw.h"
+
+#if DRAW_DEBUG_LINES
+
+#include <mutex>
+
+#include "Base/ConsoleVariable.h"
+
+static TConsoleVariable<bool> sDrawDebugLines("debug.DrawLines", true, "Draws the lines added with DEBUG_DRAW_LINE");
+
+static std::mutex sLinesMutex;
+static DebugLine sLines[DebugDraw::sCapacity];
+/* Oldest live line, the live ones follow it around the ring */
+static uint32_t sFirstLine = 0;
+static uint32_t sLineCount = 0;
+
+void DebugDraw::addLine(const DebugLine& line)
+{
+    std::lock_guard lock(sLinesMutex);
+
+    if (sLineCount < sCapacity)
+    {
+        sLines[(sFirstLine + sLineCount) % sCapacity] = line;
+        ++sLineCount;
+        return;
+    }
+
+    sLines[sFirstLine] = line;
+    sFirstLine = (sFirstLine + 1) % sCapacity;
+}
+
+void DebugDraw::extractLines(std::vector<DebugLine>& outLines, const float deltaSeconds)
+{
+    std::lock_guard lock(sLinesMutex);
+
+    const bool bDraw = sDrawDebugLines.get();
+
+    // Compacts the survivors towards the oldest slot, keeping their order.
+    uint32_t keptCount = 0;
+    for (uint32_t i = 0; i < sLineCount; ++i)
+    {
+        DebugLine line = sLines[(sFirstLine + i) % sCapacity];
+
+        if (bDraw)
+        {
+            outLines.push_back(line);
+        }
+
+        line.duration -= deltaSeconds;
+        if (line.duration < 0.f) continue;
+
+        sLines[(sFirstLine + keptCount) % sCapacity] = line;
+        ++keptCount;
+    }
+
+    sLineCount = keptCount;
+}
+
+#endif
+
+/* Only touched by drawLines on the render thread */
+static std::vector<SDL_Vertex> sLineVertices;
+static std::vector<int> sLineIndices;
+
+void DebugDraw::drawLines(SDL_Renderer* renderer, const std::vector<DebugLine>& lines, const Vector2& viewLocation)
+{
+    if (lines.empty()) return;
+
+    sLineVertices.clear();
+    sLineIndices.clear();
+
+    for (const DebugLine& line : lines)
+    {
+        const Vector2 screenStart = line.start - viewLocation;
+        const Vector2 screenEnd = line.end - viewLocation;
+
+        const Vector2 direction = screenEnd - screenStart;
+        if (direction.isAlmostZero()) continue;
+
+        // SDL_RenderLines only draws connected strips, separate lines are batched as thin quads instead.
+        const Vector2 normal = direction.getNormalized();
+        const Vector2 halfWidth = {.x = -normal.y * 0.5f, .y = normal.x * 0.5f};
+
+        const SDL_FColor color = {.r = line.color.r, .g = line.color.g, .b = line.color.b, .a = 1.f};
+        const int firstVertex = static_cast<int>(sLineVertices.size());
+
+        for (const Vector2& corner : {screenStart + halfWidth, screenStart - halfWidth, screenEnd - halfWidth, screenEnd + halfWidth})
+        {
+            sLineVertices.push_back({.position = {.x = corner.x, .y = corner.y}, .color = color, .tex_coord = {}});
+        }
+
+        for (const int corner : {0, 1, 2, 0, 2, 3})
+        {
+            sLineIndices.push_back(firstVertex + corner);
+        }
+    }
+
+    SDL_RenderGeometry(renderer, nullptr, sLineVertices.data(), static_cast<int>(sLineVertices.size()), sLineIndices.data(), static_cast<int>(sLineIndices.size()));
+}
@@ -0,0 +1,336 @@
+#include "Debugging/FrameTracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <string_view>
+
+static constexpr float sWindowDurations[] = { 1.f, 10.f, 60.f };
+
+/* Buckets grow by 2^(1/8) starting at 0.05 ms, the last one ends at ~3.3 s */
+static constexpr float sHistogramMinFrameTime = 0.00005f;
+static constexpr float sHistogramBucketsPerOctave = 8.f;
+
+const char* getFramePhaseName(const FramePhase phase)
+{
+    switch (phase)
+    {
+    case FramePhase::NetReceive:
+        return "NetReceive";
+    case FramePhase::Input:
+        return "Input";
+    case FramePhase::Tick:
+        return "Tick";
+    case FramePhase::Callbacks:
+        return "Callbacks";
+    case FramePhase::Draw:
+        return "Draw";
+    default:
+        return "Unknown";
+    }
+}
+
+const char* getFrameTimeWindowName(const FrameTimeWindow window)
+{
+    switch (window)
+    {
+    case FrameTimeWindow::OneSecond:
+        return "1s";
+    case FrameTimeWindow::TenSeconds:
+        return "10s";
+    case FrameTimeWindow::SixtySeconds:
+        return "60s";
+    default:
+        return "Unknown";
+    }
+}
+
+FrameTracker::FrameTracker()
+{
+    for (size_t i = 0; i < static_cast<size_t>(FrameTimeWindow::Count); ++i)
+    {
+        mWindows[i].duration = sWindowDurations[i];
+    }
+}
+
+uint32_t FrameTracker::getBucketIndex(const float frameTime)
+{
+    if (frameTime <= sHistogramMinFrameTime) return 0;
+
+    const float bucket = std::log2(frameTime / sHistogramMinFrameTime) * sHistogramBucketsPerOctave;
+    return std::min(static_cast<uint32_t>(bucket), sHistogramBucketCount - 1);
+}
+
+void FrameTracker::addToWindow(RollingWindow& window, const FrameSample& sample) const
+{
+    const uint32_t bucket = getBucketIndex(sample.frameTime);
+    ++window.bucketCounts[bucket];
+    window.bucketTimes[bucket] += sample.frameTime;
+
+    for (size_t i = 0; i < static_cast<size_t>(FramePhase::Count); ++i)
+    {
+        window.phaseTotals[i] += sample.phaseTimes[i];
+    }
+
+    window.totalTime += sample.frameTime;
+    ++window.sampleCount;
+}
+
+void FrameTracker::evictFromWindow(RollingWindow& window) const
+{
+    const FrameSample& sample = mSamples[window.tail];
+
+    const uint32_t bucket = getBucketIndex(sample.frameTime);
+    --window.bucketCounts[bucket];
+    window.bucketTimes[bucket] -= sample.frameTime;
+
+    for (size_t i = 0; i < static_cast<size_t>(FramePhase::Count); ++i)
+    {
+        window.phaseTotals[i] -= sample.phaseTimes[i];
+    }
+
+    window.totalTime -= sample.frameTime;
+    --window.sampleCount;
+    window.tail = (window.tail + 1) % sCapacity;
+}
+
+void FrameTracker::pushFrameTime(const float frameTime)
+{
+    lastFrameTime = frameTime;
+
+    mTotalFrameTime += frameTime;
+    ++mFrameCounter;
+
+    // The slot about to be overwritten has to leave every window that still references it.
+    for (RollingWindow& window : mWindows)
+    {
+        if (window.sampleCount == sCapacity)
+        {
+            evictFromWindow(window);
+        }
+    }
+
+    FrameSample& sample = mSamples[mHead];
+    sample.frameTime = frameTime;
+    std::ranges::copy(mCurrentPhaseTimes, sample.phaseTimes);
+    std::ranges::fill(mCurrentPhaseTimes, 0.f);
+
+    mHead = (mHead + 1) % sCapacity;
+    mSampleCount = std::min(mSampleCount + 1, sCapacity);
+
+    for (RollingWindow& window : mWindows)
+    {
+        addToWindow(window, sample);
+
+        while (window.sampleCount > 1 && window.totalTime > window.duration)
+        {
+            evictFromWindow(window);
+        }
+    }
+}
+
+void FrameTracker::addPhaseTime(const FramePhase phase, const float phaseTime)
+{
+    mCurrentPhaseTimes[static_cast<size_t>(phase)] += phaseTime;
+}
+
+float FrameTracker::getCurrentFPS() const
+{
+    return 1 / lastFrameTime;
+}
+
+float FrameTracker::getAverageFPS() const
+{
+    return mFrameCounter / mTotalFrameTime;
+}
+
+double FrameTracker::getSlowestAverageFrameTime(const RollingWindow& window, const float fraction)
+{
+    if (!window.sampleCount) return 0.0;
+
+    const double wantedCount = std::max(1.0, static_cast<double>(window.sampleCount) * fraction);
+
+    double countedFrames = 0.0;
+    double countedTime = 0.0;
+    for (uint32_t bucket = sHistogramBucketCount; bucket-- > 0 && countedFrames < wantedCount;)
+    {
+        const uint32_t bucketCount = window.bucketCounts[bucket];
+        if (!bucketCount) continue;
+
+        const double takenCount = std::min(static_cast<double>(bucketCount), wantedCount - countedFrames);
+        countedTime += window.bucketTimes[bucket] / bucketCount * takenCount;
+        countedFrames += takenCount;
+    }
+
+    return countedFrames > 0.0 ? countedTime / countedFrames : 0.0;
+}
+
+float FrameTracker::getLowestPercentageFPS(const float fraction) const
+{
+    const RollingWindow& window = mWindows[static_cast<size_t>(FrameTimeWindow::SixtySeconds)];
+    const double frameTime = getSlowestAverageFrameTime(window, std::clamp(fraction, 0.f, 1.f));
+
+    return frameTime > 0.0 ? static_cast<float>(1.0 / frameTime) : 0.f;
+}
+
+FrameTimeStats FrameTracker::getStats(const FrameTimeWindow windowType) const
+{
+    const RollingWindow& window = mWindows[static_cast<size_t>(windowType)];
+
+    FrameTimeStats stats;
+    stats.sampleCount = window.sampleCount;
+    if (!window.sampleCount) return stats;
+
+    stats.average = static_cast<float>(window.totalTime / window.sampleCount);
+    for (size_t i = 0; i < static_cast<size_t>(FramePhase::Count); ++i)
+    {
+        stats.phaseAverages[i] = static_cast<float>(window.phaseTotals[i] / window.sampleCount);
+    }
+
+    const auto getPercentile = [&](const double percentile)
+    {
+        const double rank = percentile * window.sampleCount;
+        uint32_t counted = 0;
+        for (uint32_t bucket = 0; bucket < sHistogramBucketCount; ++bucket)
+        {
+            const uint32_t bucketCount = window.bucketCounts[bucket];
+            counted += bucketCount;
+
+            if (bucketCount && counted >= rank)
+            {
+                return static_cast<float>(window.bucketTimes[bucket] / bucketCount);
+            }
+        }
+        return stats.average;
+    };
+
+    stats.p50 = getPercentile(0.5);
+    stats.p95 = getPercentile(0.95);
+    stats.p99 = getPercentile(0.99);
+
+    stats.onePercentLow = static_cast<float>(getSlowestAverageFrameTime(window, 0.01f));
+
+    return stats;
+}
+
+FrameTimeStats FrameTracker::getBufferedStats() const
+{
+    FrameTimeStats stats;
+    stats.sampleCount = mSampleCount;
+    if (!mSampleCount) return stats;
+
+    constexpr size_t phaseCount = static_cast<size_t>(FramePhase::Count);
+
+    std::vector<float> frameTimes;
+    frameTimes.reserve(mSampleCount);
+
+    double totalTime = 0.0;
+    double phaseTotals[phaseCount] = {};
+
+    // Order doesn't matter here and until the buffer wraps the first mSampleCount slots are the used ones.
+    for (uint32_t i = 0; i < mSampleCount; ++i)
+    {
+        const FrameSample& sample = mSamples[i];
+        frameTimes.push_back(sample.frameTime);
+        totalTime += sample.frameTime;
+
+        for (size_t phase = 0; phase < phaseCount; ++phase)
+        {
+            phaseTotals[phase] += sample.phaseTimes[phase];
+        }
+    }
+
+    std::ranges::sort(frameTimes);
+
+    stats.average = static_cast<float>(totalTime / mSampleCount);
+    for (size_t phase = 0; phase < phaseCount; ++phase)
+    {
+        stats.phaseAverages[phase] = static_cast<float>(phaseTotals[phase] / mSampleCount);
+    }
+
+    const auto getPercentile = [&frameTimes](const double percentile)
+    {
+        const size_t index = static_cast<size_t>(percentile * frameTimes.size());
+        return frameTimes[std::min(index, frameTimes.size() - 1)];
+    };
+
+    stats.p50 = getPercentile(0.5);
+    stats.p95 = getPercentile(0.95);
+    stats.p99 = getPercentile(0.99);
+
+    const size_t slowestCount = std::max<size_t>(1, frameTimes.size() / 100);
+    double slowestTime = 0.0;
+    for (size_t i = frameTimes.size() - slowestCount; i < frameTimes.size(); ++i)
+    {
+        slowestTime += frameTimes[i];
+    }
+    stats.onePercentLow = static_cast<float>(slowestTime / slowestCount);
+
+    return stats;
+}
+
+void FrameTracker::getRecentFrameTimes(const uint32_t count, std::vector<float>& outFrameTimes) const
+{
+    const uint32_t takenCount = std::min(count, mSampleCount);
+    outFrameTimes.clear();
+
+    for (uint32_t i = takenCount; i > 0; --i)
+    {
+        outFrameTimes.push_back(mSamples[(mHead + sCapacity - i) % sCapacity].frameTime);
+    }
+}
+
+bool FrameTracker::writeToFile(const char* path) const
+{
+    std::ofstream file(path);
+    if (!file) return false;
+
+    constexpr size_t phaseCount = static_cast<size_t>(FramePhase::Count);
+
+    if (std::string_view(path).ends_with(".json"))
+    {
+        file << std::format("{{\n  \"frameCount\": {},\n  \"averageFPS\": {:.3f},\n  \"windows\": {{", mFrameCounter, getAverageFPS());
+
+        for (size_t i = 0; i < static_cast<size_t>(FrameTimeWindow::Count); ++i)
+        {
+            const FrameTimeWindow window = static_cast<FrameTimeWindow>(i);
+            const FrameTimeStats stats = getStats(window);
+
+            file << std::format("{}\n    \"{}\": {{ \"samples\": {}, \"averageMs\": {:.4f}, \"p50Ms\": {:.4f}, \"p95Ms\": {:.4f}, \"p99Ms\": {:.4f}, \"onePercentLowMs\": {:.4f}, \"phasesMs\": {{",
+                i ? "," : "", getFrameTimeWindowName(window), stats.sampleCount, stats.average * 1000.f, stats.p50 * 1000.f, stats.p95 * 1000.f, stats.p99 * 1000.f, stats.onePercentLow * 1000.f);
+
+            for (size_t phase = 0; phase < phaseCount; ++phase)
+            {
+                file << std::format("{} \"{}\": {:.4f}", phase ? "," : "", getFramePhaseName(static_cast<FramePhase>(phase)), stats.phaseAverages[phase] * 1000.f);
+            }
+
+            file << " } }";
+        }
+
+        file << "\n  }\n}\n";
+        return static_cast<bool>(file);
+    }
+
+    file << "frame,frameMs";
+    for (size_t phase = 0; phase < phaseCount; ++phase)
+    {
+        file << "," << getFramePhaseName(static_cast<FramePhase>(phase)) << "Ms";
+    }
+    file << "\n";
+
+    const uint64_t firstFrame = mFrameCounter - mSampleCount;
+    for (uint32_t i = 0; i < mSampleCount; ++i)
+    {
+        const FrameSample& sample = mSamples[(mHead + sCapacity - mSampleCount + i) % sCapacity];
+
+        file << std::format("{},{:.4f}", firstFrame + i, sample.frameTime * 1000.f);
+        for (const float phaseTime : sample.phaseTimes)
+        {
+            file << std::format(",{:.4f}", phaseTime * 1000.f);
+        }
+        file << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,156 @@
+#include "Debugging/Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+Logger::LogRecord Logger::sRecords[sSlotCount];
+std::atomic<uint64_t> Logger::sWriteIndex = 0;
+std::atomic<uint64_t> Logger::sDroppedCount = 0;
+std::atomic<LogSeverity> Logger::sMinSeverity = LogSeverity::Info;
+
+static std::thread sLogThread;
+static std::atomic<bool> bLogThreadRunning = false;
+static std::ofstream sLogFile;
+
+/* Only touched by the logging thread */
+static uint64_t sReadIndex = 0;
+
+static uint64_t getTimestamp()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static const uint64_t sStartNanoseconds = getTimestamp();
+
+const char* getLogSeverityName(const LogSeverity severity)
+{
+    switch (severity)
+    {
+    case LogSeverity::Verbose:
+        return "Verbose";
+    case LogSeverity::Info:
+        return "Info";
+    case LogSeverity::Warning:
+        return "Warning";
+    case LogSeverity::Error:
+        return "Error";
+    default:
+        return "Unknown";
+    }
+}
+
+Logger::LogRecord* Logger::acquireRecord(const LogSeverity severity, const std::string_view format)
+{
+    uint64_t writeIndex = sWriteIndex.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        LogRecord& record = sRecords[writeIndex % sSlotCount];
+        const uint64_t writeTurn = writeIndex / sSlotCount * 2;
+        const uint64_t turn = record.turn.load(std::memory_order_acquire);
+
+        if (turn == writeTurn)
+        {
+            if (sWriteIndex.compare_exchange_weak(writeIndex, writeIndex + 1, std::memory_order_relaxed)) break;
+        }
+        else if (turn < writeTurn)
+        {
+            // The logging thread hasn't caught up with this slot yet, losing a record beats stalling the caller.
+            sDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else
+        {
+            writeIndex = sWriteIndex.load(std::memory_order_relaxed);
+        }
+    }
+
+    LogRecord& record = sRecords[writeIndex % sSlotCount];
+    record.severity = severity;
+    record.format = format.data();
+    record.formatSize = static_cast<uint32_t>(format.size());
+    record.timestampNanoseconds = getTimestamp();
+
+    return &record;
+}
+
+void Logger::publishRecord(LogRecord* record)
+{
+    record->turn.fetch_add(1, std::memory_order_release);
+}
+
+bool Logger::drainRecords(std::string& text, std::string& line)
+{
+    bool bWroteAny = false;
+
+    for (;;)
+    {
+        LogRecord& record = sRecords[sReadIndex % sSlotCount];
+        const uint64_t readTurn = sReadIndex / sSlotCount * 2 + 1;
+        if (record.turn.load(std::memory_order_acquire) != readTurn) break;
+
+        record.formatFunction({record.format, record.formatSize}, record.payload, text);
+
+        const double seconds = static_cast<double>(record.timestampNanoseconds - sStartNanoseconds) / 1e9;
+        line = std::format("[{:10.4f}][{}] {}\n", seconds, getLogSeverityName(record.severity), text);
+
+        fputs(line.c_str(), stderr);
+        if (sLogFile.is_open())
+        {
+            sLogFile << line;
+        }
+
+        // Frees the slot for the writers of the next lap.
+        record.turn.store(readTurn + 1, std::memory_order_release);
+        ++sReadIndex;
+        bWroteAny = true;
+    }
+
+    if (const uint64_t dropped = sDroppedCount.exchange(0, std::memory_order_relaxed))
+    {
+        line = std::format("[Logger] Dropped {} records, the ring buffer was full\n", dropped);
+        fputs(line.c_str(), stderr);
+        bWroteAny = true;
+    }
+
+    return bWroteAny;
+}
+
+void Logger::start(const char* filePath)
+{
+    if (bLogThreadRunning.exchange(true)) return;
+
+    if (filePath)
+    {
+        sLogFile.open(filePath, std::ios::trunc);
+    }
+
+    sLogThread = std::thread([]()
+    {
+        std::string text;
+        std::string line;
+
+        while (bLogThreadRunning.load(std::memory_order_relaxed))
+        {
+            if (!drainRecords(text, line))
+            {
+                // Polling keeps writers free of any wake up call, a few milliseconds of delay don't matter for logs.
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+
+        drainRecords(text, line);
+        fflush(stderr);
+    });
+}
+
+void Logger::stop()
+{
+    if (!bLogThreadRunning.exchange(false)) return;
+
+    sLogThread.join();
+    sLogFile.close();
+}
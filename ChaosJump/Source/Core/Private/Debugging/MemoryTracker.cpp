@@ -0,0 +1,185 @@
+#include "Debugging/MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <new>
+
+/* Constant initialized, operator new can run before any dynamic initialization */
+struct MemoryTagCounters
+{
+    std::atomic<uint64_t> allocationCount = 0;
+    std::atomic<uint64_t> allocatedBytes = 0;
+    std::atomic<int64_t> liveBytes = 0;
+    std::atomic<int64_t> peakLiveBytes = 0;
+
+    std::atomic<uint64_t> currentFrameAllocationCount = 0;
+    std::atomic<uint64_t> currentFrameAllocatedBytes = 0;
+    std::atomic<uint64_t> frameAllocationCount = 0;
+    std::atomic<uint64_t> frameAllocatedBytes = 0;
+    std::atomic<uint64_t> peakFrameAllocationCount = 0;
+};
+
+static MemoryTagCounters sCounters[static_cast<size_t>(MemoryTag::Count)];
+static thread_local MemoryTag sThreadTag = MemoryTag::Core;
+
+template<typename T>
+static void storeMax(std::atomic<T>& target, const T value)
+{
+    T current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+const char* getMemoryTagName(const MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::Core:
+        return "Core";
+    case MemoryTag::Physics:
+        return "Physics";
+    case MemoryTag::Networking:
+        return "Networking";
+    case MemoryTag::Rendering:
+        return "Rendering";
+    case MemoryTag::Gameplay:
+        return "Gameplay";
+    default:
+        return "Unknown";
+    }
+}
+
+MemoryTag MemoryTracker::getThreadTag()
+{
+    return sThreadTag;
+}
+
+MemoryTag MemoryTracker::setThreadTag(const MemoryTag tag)
+{
+    const MemoryTag previousTag = sThreadTag;
+    sThreadTag = tag;
+    return previousTag;
+}
+
+void MemoryTracker::recordAllocation(const MemoryTag tag, const size_t size)
+{
+    MemoryTagCounters& counters = sCounters[static_cast<size_t>(tag)];
+
+    counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    counters.currentFrameAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    counters.currentFrameAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    const int64_t liveBytes = counters.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+    storeMax(counters.peakLiveBytes, liveBytes);
+}
+
+void MemoryTracker::recordFree(const MemoryTag tag, const size_t size)
+{
+    sCounters[static_cast<size_t>(tag)].liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+void MemoryTracker::endFrame()
+{
+    for (MemoryTagCounters& counters : sCounters)
+    {
+        const uint64_t frameAllocationCount = counters.currentFrameAllocationCount.exchange(0, std::memory_order_relaxed);
+        counters.frameAllocationCount.store(frameAllocationCount, std::memory_order_relaxed);
+        counters.frameAllocatedBytes.store(counters.currentFrameAllocatedBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        storeMax(counters.peakFrameAllocationCount, frameAllocationCount);
+    }
+}
+
+MemoryTagStats MemoryTracker::getStats(const MemoryTag tag)
+{
+    const MemoryTagCounters& counters = sCounters[static_cast<size_t>(tag)];
+
+    return
+    {
+        .allocationCount = counters.allocationCount.load(std::memory_order_relaxed),
+        .allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed),
+        .liveBytes = counters.liveBytes.load(std::memory_order_relaxed),
+        .peakLiveBytes = counters.peakLiveBytes.load(std::memory_order_relaxed),
+        .frameAllocationCount = counters.frameAllocationCount.load(std::memory_order_relaxed),
+        .frameAllocatedBytes = counters.frameAllocatedBytes.load(std::memory_order_relaxed),
+        .peakFrameAllocationCount = counters.peakFrameAllocationCount.load(std::memory_order_relaxed)
+    };
+}
+
+bool MemoryTracker::writeReport(const char* path)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) return false;
+
+    file << std::format("{:<12}{:>14}{:>16}{:>14}{:>14}{:>14}{:>14}{:>16}\n",
+        "Tag", "Allocations", "Allocated KB", "Live KB", "Peak KB", "Frame allocs", "Frame KB", "Peak frame allocs");
+
+    for (size_t tag = 0; tag < static_cast<size_t>(MemoryTag::Count); ++tag)
+    {
+        const MemoryTagStats stats = getStats(static_cast<MemoryTag>(tag));
+
+        file << std::format("{:<12}{:>14}{:>16.1f}{:>14.1f}{:>14.1f}{:>14}{:>14.1f}{:>16}\n",
+            getMemoryTagName(static_cast<MemoryTag>(tag)), stats.allocationCount, stats.allocatedBytes / 1024.0, stats.liveBytes / 1024.0,
+            stats.peakLiveBytes / 1024.0, stats.frameAllocationCount, stats.frameAllocatedBytes / 1024.0, stats.peakFrameAllocationCount);
+    }
+
+    return file.good();
+}
+
+#if ENABLE_MEMORY_TRACKING
+
+struct AllocationHeader
+{
+    size_t size;
+    MemoryTag tag;
+};
+
+/* Keeps the memory handed out at the alignment plain operator new guarantees */
+static constexpr size_t sHeaderSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static_assert(sizeof(AllocationHeader) <= sHeaderSize);
+
+static void* allocateTracked(const size_t size) noexcept
+{
+    std::byte* block = static_cast<std::byte*>(std::malloc(size + sHeaderSize));
+    if (!block) return nullptr;
+
+    const MemoryTag tag = MemoryTracker::getThreadTag();
+    new (block) AllocationHeader{.size = size, .tag = tag};
+    MemoryTracker::recordAllocation(tag, size);
+
+    return block + sHeaderSize;
+}
+
+static void freeTracked(void* memory) noexcept
+{
+    if (!memory) return;
+
+    std::byte* block = static_cast<std::byte*>(memory) - sHeaderSize;
+    const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(block);
+    MemoryTracker::recordFree(header->tag, header->size);
+
+    std::free(block);
+}
+
+static void* allocateTrackedOrThrow(const size_t size)
+{
+    // Zero sized allocations still have to return unique pointers.
+    void* memory = allocateTracked(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(const size_t size) { return allocateTrackedOrThrow(size); }
+void* operator new[](const size_t size) { return allocateTrackedOrThrow(size); }
+void* operator new(const size_t size, const std::nothrow_t&) noexcept { return allocateTracked(size ? size : 1); }
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept { return allocateTracked(size ? size : 1); }
+
+void operator delete(void* memory) noexcept { freeTracked(memory); }
+void operator delete[](void* memory) noexcept { freeTracked(memory); }
+void operator delete(void* memory, size_t) noexcept { freeTracked(memory); }
+void operator delete[](void* memory, size_t) noexcept { freeTracked(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { freeTracked(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { freeTracked(memory); }
+
+#endif
@@ -0,0 +1,184 @@
+#include "Debugging/PhysicsRecorder.h"
+
+#if ENABLE_PHYSICS_RECORDER
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+#include "Base/ConsoleVariable.h"
+#include "Physics/CollisionObject.h"
+#include "Render/RenderPacket.h"
+
+static TConsoleVariable<bool> sRecordPhysics("debug.RecordPhysics", false, "Keeps the last frames of physics state for the recorder viewer and dumps");
+
+static PhysicsFrameRecord sFrames[PhysicsRecorder::sFrameCapacity];
+/* Slot the next frame gets recorded into */
+static uint32_t sNextFrame = 0;
+static uint32_t sFrameCount = 0;
+
+static bool bViewerOpen = false;
+/* Frames back from the newest one */
+static uint32_t sViewedFrameAge = 0;
+
+static const PhysicsFrameRecord& getFrameByAge(const uint32_t age)
+{
+    return sFrames[(sNextFrame + PhysicsRecorder::sFrameCapacity - 1 - age) % PhysicsRecorder::sFrameCapacity];
+}
+
+static const char* getCategoryName(const CollisionCategory category)
+{
+    switch (category)
+    {
+    case CollisionCategory::Ground: return "Ground";
+    case CollisionCategory::Obstacle: return "Obstacle";
+    case CollisionCategory::Player: return "Player";
+    default: return "Unknown";
+    }
+}
+
+void PhysicsRecorder::recordFrame(const uint64_t frameNumber, const float deltaSeconds)
+{
+    if (bViewerOpen || !sRecordPhysics.get()) return;
+
+    PhysicsFrameRecord& frame = sFrames[sNextFrame];
+    frame.frameNumber = frameNumber;
+    frame.deltaSeconds = deltaSeconds;
+    frame.bodies.clear();
+
+    for (const auto& [collisionCategory, bucket] : CollisionObject::sCollisionCategoryBuckets)
+    {
+        for (const CollisionObject* body : bucket)
+        {
+            // The move result is stale for bodies that didn't move this frame.
+            const bool bMoved = body->mLastMoveFrame == frameNumber;
+            const CollisionResult& result = body->mLastMoveResult;
+
+            frame.bodies.push_back({
+                .body = body,
+                .otherBody = bMoved ? result.collisionObject : nullptr,
+                .location = body->mLocation,
+                .velocity = body->mVelocity,
+                .collisionNormal = bMoved ? result.collisionNormal : Vector2{},
+                .category = collisionCategory,
+                .bMoved = bMoved,
+                .bCollided = bMoved && result.bCollided,
+                .bBlocked = bMoved && result.bBlocked
+            });
+        }
+    }
+
+    sNextFrame = (sNextFrame + 1) % sFrameCapacity;
+    sFrameCount = std::min(sFrameCount + 1, sFrameCapacity);
+}
+
+bool PhysicsRecorder::writeToFile(const char* path)
+{
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "frame,deltaSeconds,body,category,x,y,velocityX,velocityY,moved,collided,blocked,normalX,normalY,otherBody\n";
+
+    for (uint32_t age = sFrameCount; age-- > 0;)
+    {
+        const PhysicsFrameRecord& frame = getFrameByAge(age);
+        for (const PhysicsBodyRecord& body : frame.bodies)
+        {
+            file << std::format("{},{:.6f},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:d},{:d},{:d},{:.4f},{:.4f},{}\n",
+                frame.frameNumber, frame.deltaSeconds, static_cast<const void*>(body.body), getCategoryName(body.category),
+                body.location.x, body.location.y, body.velocity.x, body.velocity.y, body.bMoved, body.bCollided, body.bBlocked,
+                body.collisionNormal.x, body.collisionNormal.y, static_cast<const void*>(body.otherBody));
+        }
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool PhysicsRecorder::isViewing()
+{
+    return bViewerOpen;
+}
+
+void PhysicsRecorder::setViewing(const bool bViewing)
+{
+    bViewerOpen = bViewing;
+    sViewedFrameAge = 0;
+}
+
+void PhysicsRecorder::scrub(const int32_t frameOffset)
+{
+    if (sFrameCount == 0) return;
+
+    const int64_t age = static_cast<int64_t>(sViewedFrameAge) - frameOffset;
+    sViewedFrameAge = static_cast<uint32_t>(std::clamp<int64_t>(age, 0, sFrameCount - 1));
+}
+
+void PhysicsRecorder::extractViewerFrame(RenderPacket& packet)
+{
+    if (!bViewerOpen) return;
+
+    constexpr float markerSize = 6.f;
+    constexpr float velocitySeconds = 0.1f;
+    constexpr float normalLength = 40.f;
+
+    if (sFrameCount == 0)
+    {
+        packet.displayTexts.push_back({.screenPosition = {.x = 0, .y = -0.85f}, .text = "Physics recorder: no frames recorded", .textScale = {.x = 1.5f, .y = 1.5f}});
+        return;
+    }
+
+    const PhysicsFrameRecord& frame = getFrameByAge(sViewedFrameAge);
+
+    uint32_t collidedCount = 0;
+    uint32_t blockedCount = 0;
+
+    for (const PhysicsBodyRecord& body : frame.bodies)
+    {
+        collidedCount += body.bCollided;
+        blockedCount += body.bBlocked;
+
+        Color color = body.bMoved ? Color{.r = 1, .g = 1, .b = 1} : Color{.r = 0.4f, .g = 0.4f, .b = 0.4f};
+        if (body.bBlocked)
+        {
+            color = {.r = 1, .g = 0, .b = 0};
+        }
+        else if (body.bCollided)
+        {
+            color = {.r = 1, .g = 1, .b = 0};
+        }
+
+        const Vector2& location = body.location;
+        packet.debugLines.push_back({.start = location - Vector2{.x = markerSize, .y = 0}, .end = location + Vector2{.x = markerSize, .y = 0}, .color = color});
+        packet.debugLines.push_back({.start = location - Vector2{.x = 0, .y = markerSize}, .end = location + Vector2{.x = 0, .y = markerSize}, .color = color});
+
+        if (body.bMoved && !body.velocity.isAlmostZero())
+        {
+            packet.debugLines.push_back({.start = location, .end = location + body.velocity * velocitySeconds, .color = {.r = 0, .g = 1, .b = 1}});
+        }
+
+        if (body.bCollided)
+        {
+            packet.debugLines.push_back({.start = location, .end = location + body.collisionNormal * normalLength, .color = {.r = 0, .g = 1, .b = 0}});
+        }
+    }
+
+    packet.displayTexts.push_back({
+        .screenPosition = {.x = 0, .y = -0.85f},
+        .text = std::format("Physics frame {} ({}/{}), {:.2f} ms, {} bodies, {} collided, {} blocked",
+            frame.frameNumber, sFrameCount - sViewedFrameAge, sFrameCount, frame.deltaSeconds * 1000.f, frame.bodies.size(), collidedCount, blockedCount),
+        .textScale = {.x = 1.5f, .y = 1.5f}
+    });
+
+    packet.displayTexts.push_back({
+        .screenPosition = {.x = 0, .y = -0.8f},
+        .text = "Left/Right scrub, Shift steps 10 frames, F6 dumps, F7 resumes recording",
+        .color = {.r = 0.6f, .g = 0.6f, .b = 0.6f}
+    });
+}
+
+uint32_t PhysicsRecorder::getFrameCount()
+{
+    return sFrameCount;
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include "Debugging/Profiler.h"
+
+#include <chrono>
+#include <format>
+#include <fstream>
+
+std::atomic<bool> Profiler::bCapturing = false;
+std::atomic<uint32_t> Profiler::sCaptureId = 0;
+std::atomic<uint64_t> Profiler::sCaptureStartNanoseconds = 0;
+std::mutex Profiler::sThreadBuffersMutex;
+std::vector<std::unique_ptr<Profiler::ThreadBuffer>> Profiler::sThreadBuffers;
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer()
+{
+    thread_local ThreadBuffer* threadBuffer = nullptr;
+
+    if (!threadBuffer)
+    {
+        std::lock_guard lock(sThreadBuffersMutex);
+
+        std::unique_ptr<ThreadBuffer>& newBuffer = sThreadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+        newBuffer->threadIndex = static_cast<uint32_t>(sThreadBuffers.size() - 1);
+        threadBuffer = newBuffer.get();
+    }
+
+    return *threadBuffer;
+}
+
+uint64_t Profiler::getTimestamp()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::startCapture()
+{
+    sCaptureStartNanoseconds.store(getTimestamp(), std::memory_order_relaxed);
+    sCaptureId.fetch_add(1, std::memory_order_release);
+    bCapturing.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::stopCapture()
+{
+    bCapturing.store(false, std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const char* name)
+{
+    getThreadBuffer().threadName.store(name, std::memory_order_release);
+}
+
+uint32_t Profiler::beginZone()
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    return buffer.depth++;
+}
+
+void Profiler::endZone(const char* name, const uint64_t startNanoseconds, const uint32_t depth)
+{
+    const uint64_t endNanoseconds = getTimestamp();
+
+    ThreadBuffer& buffer = getThreadBuffer();
+    buffer.depth = depth;
+
+    const uint32_t captureId = sCaptureId.load(std::memory_order_acquire);
+    if (buffer.captureId.load(std::memory_order_relaxed) != captureId)
+    {
+        // First zone of this thread in a new capture, the count is reset before the id is published.
+        buffer.zoneCount.store(0, std::memory_order_relaxed);
+        buffer.droppedZoneCount.store(0, std::memory_order_relaxed);
+        buffer.captureId.store(captureId, std::memory_order_release);
+    }
+
+    // Zones opened before the capture started would end up with a negative timestamp.
+    if (startNanoseconds < sCaptureStartNanoseconds.load(std::memory_order_relaxed)) return;
+
+    const uint32_t zoneCount = buffer.zoneCount.load(std::memory_order_relaxed);
+    if (zoneCount >= sZonesPerThread)
+    {
+        buffer.droppedZoneCount.store(buffer.droppedZoneCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.zones[zoneCount] = {.name = name, .startNanoseconds = startNanoseconds, .endNanoseconds = endNanoseconds, .depth = depth};
+    buffer.zoneCount.store(zoneCount + 1, std::memory_order_release);
+}
+
+bool Profiler::writeTrace(const char* path)
+{
+    std::ofstream file(path);
+    if (!file) return false;
+
+    const uint32_t captureId = sCaptureId.load(std::memory_order_acquire);
+    const uint64_t captureStartNanoseconds = sCaptureStartNanoseconds.load(std::memory_order_relaxed);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool bFirstEvent = true;
+    const auto writeSeparator = [&file, &bFirstEvent]()
+    {
+        file << (bFirstEvent ? "\n" : ",\n");
+        bFirstEvent = false;
+    };
+
+    std::lock_guard lock(sThreadBuffersMutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : sThreadBuffers)
+    {
+        if (buffer->captureId.load(std::memory_order_acquire) != captureId) continue;
+
+        const uint32_t threadIndex = buffer->threadIndex;
+        const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+
+        writeSeparator();
+        if (threadName)
+        {
+            file << std::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{}"}}}})", threadIndex, threadName);
+        }
+        else
+        {
+            file << std::format(R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"Thread {}"}}}})", threadIndex, threadIndex);
+        }
+
+        if (const uint32_t droppedZoneCount = buffer->droppedZoneCount.load(std::memory_order_relaxed))
+        {
+            writeSeparator();
+            file << std::format(R"({{"name":"dropped_zones","ph":"M","pid":0,"tid":{},"args":{{"count":{}}}}})", threadIndex, droppedZoneCount);
+        }
+
+        const uint32_t zoneCount = buffer->zoneCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < zoneCount; ++i)
+        {
+            const ProfileZone& zone = buffer->zones[i];
+            const double startMicroseconds = (zone.startNanoseconds - captureStartNanoseconds) / 1000.0;
+            const double durationMicroseconds = (zone.endNanoseconds - zone.startNanoseconds) / 1000.0;
+
+            writeSeparator();
+            file << std::format(R"({{"name":"{}","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"depth":{}}}}})",
+                zone.name, threadIndex, startMicroseconds, durationMicroseconds, zone.depth);
+        }
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,148 @@
+#include "Entities/EntityStore.h"
+
+#include <algorithm>
+
+uint32_t EntityArchetype::addRow(const uint32_t entityIndex)
+{
+    EntityComponentList::forEach([this]<typename Component>(std::type_identity<Component>)
+    {
+        if (hasComponents(getComponentBit<Component>()))
+        {
+            getColumn<Component>().emplace_back();
+        }
+    });
+
+    mEntityIndices.push_back(entityIndex);
+    return getSize() - 1;
+}
+
+uint32_t EntityArchetype::removeRow(const uint32_t row)
+{
+    const uint32_t lastRow = getSize() - 1;
+
+    EntityComponentList::forEach([this, row, lastRow]<typename Component>(std::type_identity<Component>)
+    {
+        if (!hasComponents(getComponentBit<Component>())) return;
+
+        std::vector<Component>& column = getColumn<Component>();
+        if (row != lastRow)
+        {
+            column[row] = std::move(column[lastRow]);
+        }
+        column.pop_back();
+    });
+
+    const uint32_t movedEntityIndex = row != lastRow ? mEntityIndices[lastRow] : UINT32_MAX;
+    mEntityIndices[row] = mEntityIndices[lastRow];
+    mEntityIndices.pop_back();
+
+    return movedEntityIndex;
+}
+
+void EntityArchetype::moveRowTo(const uint32_t row, EntityArchetype& otherArchetype, const uint32_t otherRow)
+{
+    const ComponentMask sharedMask = mMask & otherArchetype.mMask;
+
+    EntityComponentList::forEach([this, row, &otherArchetype, otherRow, sharedMask]<typename Component>(std::type_identity<Component>)
+    {
+        if (sharedMask & getComponentBit<Component>())
+        {
+            otherArchetype.getColumn<Component>()[otherRow] = std::move(getColumn<Component>()[row]);
+        }
+    });
+}
+
+uint32_t EntityStore::findOrCreateArchetype(const ComponentMask mask)
+{
+    const auto it = std::ranges::find_if(mArchetypes, [mask](const std::unique_ptr<EntityArchetype>& archetype)
+    {
+        return archetype->getMask() == mask;
+    });
+
+    if (it != mArchetypes.end())
+    {
+        return static_cast<uint32_t>(it - mArchetypes.begin());
+    }
+
+    mArchetypes.push_back(std::make_unique<EntityArchetype>(mask));
+    return static_cast<uint32_t>(mArchetypes.size() - 1);
+}
+
+const EntityStore::EntityRecord* EntityStore::findRecord(const EntityHandle entity) const
+{
+    if (entity.index >= mEntities.size()) return nullptr;
+
+    const EntityRecord& record = mEntities[entity.index];
+    return record.bAlive && record.generation == entity.generation ? &record : nullptr;
+}
+
+EntityHandle EntityStore::createEntity(const ComponentMask mask)
+{
+    uint32_t entityIndex;
+    if (!mFreeEntityIndices.empty())
+    {
+        entityIndex = mFreeEntityIndices.back();
+        mFreeEntityIndices.pop_back();
+    }
+    else
+    {
+        entityIndex = static_cast<uint32_t>(mEntities.size());
+        mEntities.emplace_back();
+    }
+
+    EntityRecord& record = mEntities[entityIndex];
+    record.archetypeIndex = findOrCreateArchetype(mask);
+    record.row = mArchetypes[record.archetypeIndex]->addRow(entityIndex);
+    record.bAlive = true;
+
+    ++mEntityCount;
+    return {.index = entityIndex, .generation = record.generation};
+}
+
+void EntityStore::destroyEntity(const EntityHandle entity)
+{
+    if (!findRecord(entity)) return;
+
+    EntityRecord& record = mEntities[entity.index];
+
+    const uint32_t movedEntityIndex = mArchetypes[record.archetypeIndex]->removeRow(record.row);
+    if (movedEntityIndex != UINT32_MAX)
+    {
+        mEntities[movedEntityIndex].row = record.row;
+    }
+
+    record.bAlive = false;
+    ++record.generation;
+    mFreeEntityIndices.push_back(entity.index);
+    --mEntityCount;
+}
+
+ComponentMask EntityStore::getComponentMask(const EntityHandle entity) const
+{
+    const EntityRecord* record = findRecord(entity);
+    return record ? mArchetypes[record->archetypeIndex]->getMask() : 0;
+}
+
+void EntityStore::setComponentMask(const EntityHandle entity, const ComponentMask mask)
+{
+    if (!findRecord(entity)) return;
+
+    EntityRecord& record = mEntities[entity.index];
+    const uint32_t newArchetypeIndex = findOrCreateArchetype(mask);
+    if (newArchetypeIndex == record.archetypeIndex) return;
+
+    EntityArchetype& oldArchetype = *mArchetypes[record.archetypeIndex];
+    EntityArchetype& newArchetype = *mArchetypes[newArchetypeIndex];
+
+    const uint32_t newRow = newArchetype.addRow(entity.index);
+    oldArchetype.moveRowTo(record.row, newArchetype, newRow);
+
+    const uint32_t movedEntityIndex = oldArchetype.removeRow(record.row);
+    if (movedEntityIndex != UINT32_MAX)
+    {
+        mEntities[movedEntityIndex].row = record.row;
+    }
+
+    record.archetypeIndex = newArchetypeIndex;
+    record.row = newRow;
+}
@@ -0,0 +1,54 @@
+#include "Entities/EntitySystems.h"
+
+#include "Entities/EntityStore.h"
+#include "Physics/CollisionObject.h"
+#include "Render/RenderPacket.h"
+
+void integrateEntityBodies(EntityStore& entityStore, const float deltaTime)
+{
+    entityStore.forEach<TransformComponent, BodyComponent>([deltaTime](EntityHandle, TransformComponent& transform, BodyComponent& body)
+    {
+        body.velocity = applyDamping(body.velocity, body.dampingPerSecond, deltaTime);
+
+        transform.location += body.velocity * deltaTime;
+        body.velocity += body.gravity * deltaTime;
+    });
+}
+
+void appendEntityRenderItems(const EntityStore& entityStore, RenderPacket& packet, const Vector2& viewLocation, const Vector2& windowSize)
+{
+    constexpr ComponentMask renderMask = makeComponentMask<TransformComponent, RenderMeshComponent, ColorComponent>();
+
+    for (const std::unique_ptr<EntityArchetype>& archetype : entityStore.getArchetypes())
+    {
+        if (!archetype->hasComponents(renderMask)) continue;
+
+        const std::vector<TransformComponent>& transforms = archetype->getColumn<TransformComponent>();
+        const std::vector<RenderMeshComponent>& meshes = archetype->getColumn<RenderMeshComponent>();
+        const std::vector<ColorComponent>& colors = archetype->getColumn<ColorComponent>();
+
+        const bool bHasBounds = archetype->hasComponents(getComponentBit<ShapeComponent>());
+        const std::vector<ShapeComponent>& shapes = archetype->getColumn<ShapeComponent>();
+
+        for (uint32_t row = 0; row < archetype->getSize(); ++row)
+        {
+            const Vector2 screenLocation = transforms[row].location - viewLocation;
+
+            if (bHasBounds)
+            {
+                const Vector2& extent = shapes[row].boundsExtent;
+                const bool outOfXBounds = screenLocation.x + extent.x < 0 || screenLocation.x - extent.x > windowSize.x;
+                const bool outOfYBounds = screenLocation.y + extent.y < 0 || screenLocation.y - extent.y > windowSize.y;
+                if (outOfXBounds || outOfYBounds) continue;
+            }
+
+            if (!meshes[row].mesh) continue;
+
+            RenderItem& item = packet.items.emplace_back();
+            item.type = RenderItemType::Geometry;
+            item.screenLocation = screenLocation;
+            item.color = colors[row].color;
+            item.mesh = meshes[row].mesh;
+        }
+    }
+}
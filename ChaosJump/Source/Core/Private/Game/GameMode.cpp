@@ -32,4 +32,9 @@ void GameMode::addPlayer(Player* player)
 void GameMode::removePlayer(Player* player)
 {
     std::erase(mPlayers, player);
+}
+
+void GameMode::appendObjectCounts(std::vector<ObjectCount>& outCounts) const
+{
+    outCounts.push_back({.name = "players", .count = static_cast<uint32_t>(mPlayers.size())});
 }
\ No newline at end of file
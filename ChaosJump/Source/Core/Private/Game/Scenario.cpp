@@ -0,0 +1,126 @@
+#include "Game/Scenario.h"
+
+#include <cstring>
+#include <fstream>
+
+#include "Objects/Circle.h"
+#include "Objects/Platform.h"
+#include "Objects/Polygon.h"
+#include "Objects/Rectangle.h"
+
+bool Scenario::open(const char* path)
+{
+    close();
+
+    if (!mFile.open(path)) return false;
+
+    const std::byte* data = mFile.getData();
+    const size_t size = mFile.getSize();
+
+    const ScenarioHeader* header = reinterpret_cast<const ScenarioHeader*>(data);
+    if (size < sizeof(ScenarioHeader) || memcmp(header->magic, sMagic, sizeof(sMagic)) != 0 || header->version != sVersion || header->headerSize != sizeof(ScenarioHeader))
+    {
+        close();
+        return false;
+    }
+
+    const uint64_t expectedSize = sizeof(ScenarioHeader) + uint64_t{header->bodyCount} * sizeof(ScenarioBody) + uint64_t{header->vertexCount} * sizeof(Vector2);
+    if (size != expectedSize)
+    {
+        close();
+        return false;
+    }
+
+    const ScenarioBody* bodies = reinterpret_cast<const ScenarioBody*>(data + sizeof(ScenarioHeader));
+    const Vector2* vertices = reinterpret_cast<const Vector2*>(bodies + header->bodyCount);
+
+    // Checked once here so loading can take every body as is.
+    for (uint32_t i = 0; i < header->bodyCount; ++i)
+    {
+        const ScenarioBody& body = bodies[i];
+
+        const bool bValidType = body.type <= ScenarioBodyType::Polygon;
+        const bool bValidVertices = body.type != ScenarioBodyType::Polygon || (body.vertexCount >= 3 && uint64_t{body.firstVertex} + body.vertexCount <= header->vertexCount);
+        if (!bValidType || !bValidVertices)
+        {
+            close();
+            return false;
+        }
+    }
+
+    mHeader = header;
+    mBodies = {bodies, header->bodyCount};
+    mVertices = {vertices, header->vertexCount};
+    return true;
+}
+
+void Scenario::close()
+{
+    mFile.close();
+    mHeader = nullptr;
+    mBodies = {};
+    mVertices = {};
+}
+
+bool ScenarioWriter::addBody(const CollisionObject& object)
+{
+    ScenarioBody body;
+    body.location = object.getLocation();
+    body.velocity = object.getVelocity();
+
+    // Platform first, it is a rectangle as well.
+    if (const Platform* platform = dynamic_cast<const Platform*>(&object))
+    {
+        body.type = ScenarioBodyType::Platform;
+        body.color = platform->getColor();
+    }
+    else if (const Circle* circle = dynamic_cast<const Circle*>(&object))
+    {
+        body.type = ScenarioBodyType::Circle;
+        body.color = circle->getColor();
+        body.size = {.x = circle->getRadius(), .y = circle->getRadius()};
+    }
+    else if (const Rectangle* rectangle = dynamic_cast<const Rectangle*>(&object))
+    {
+        body.type = ScenarioBodyType::Rectangle;
+        body.color = rectangle->getColor();
+        body.size = {.x = rectangle->getWidth(), .y = rectangle->getHeight()};
+    }
+    else if (const Polygon* polygon = dynamic_cast<const Polygon*>(&object))
+    {
+        const std::vector<Vector2>& vertices = polygon->getVertices();
+
+        body.type = ScenarioBodyType::Polygon;
+        body.color = polygon->getColor();
+        body.firstVertex = static_cast<uint32_t>(mVertices.size());
+        body.vertexCount = static_cast<uint32_t>(vertices.size());
+        mVertices.insert(mVertices.end(), vertices.begin(), vertices.end());
+    }
+    else
+    {
+        return false;
+    }
+
+    mBodies.push_back(body);
+    return true;
+}
+
+bool ScenarioWriter::write(const char* path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    ScenarioHeader header;
+    memcpy(header.magic, Scenario::sMagic, sizeof(Scenario::sMagic));
+    header.version = Scenario::sVersion;
+    header.headerSize = sizeof(ScenarioHeader);
+    header.bodyCount = static_cast<uint32_t>(mBodies.size());
+    header.vertexCount = static_cast<uint32_t>(mVertices.size());
+    header.playerSpawnLocation = mPlayerSpawnLocation;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(mBodies.data()), static_cast<std::streamsize>(mBodies.size() * sizeof(ScenarioBody)));
+    file.write(reinterpret_cast<const char*>(mVertices.data()), static_cast<std::streamsize>(mVertices.size() * sizeof(Vector2)));
+
+    return file.good();
+}
@@ -2,6 +2,15 @@
 
 #include "Input/InputRouter.h"
 
+KeyTriggerTickable::KeyTriggerTickable(InputReceiverInterface& inputReceiver) : TickableInterface(TickPhase::Parallel), mInputReceiver(inputReceiver)
+{
+}
+
+void KeyTriggerTickable::tick(const float deltaTime)
+{
+    mInputReceiver.pollKeyTriggers(deltaTime);
+}
+
 void InputReceiverInterface::handleKeyInput(const SDL_Scancode scancode, const bool bPressed)
 {
     const bool bWasPressed = mKeyDownMap[scancode]; 
@@ -31,7 +40,7 @@ void InputReceiverInterface::handleKeyReleased(const SDL_Scancode scancode)
 {
 }
 
-void InputReceiverInterface::tick(float deltaTime)
+void InputReceiverInterface::pollKeyTriggers(const float deltaTime)
 {
     for (const auto [scanCode, bPressed]: mKeyDownMap)
     {
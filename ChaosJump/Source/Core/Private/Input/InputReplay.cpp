@@ -0,0 +1,198 @@
+#include "Input/InputReplay.h"
+
+#include <cstring>
+#include <iterator>
+
+#include "Debugging/DebugDefinitions.h"
+#include "Debugging/Logger.h"
+#include "Input/InputRouter.h"
+
+InputReplay::~InputReplay()
+{
+    stop();
+}
+
+template<typename T>
+void InputReplay::write(const T& value)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    mBuffer.insert(mBuffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+bool InputReplay::read(T& outValue)
+{
+    if (mReadOffset + sizeof(T) > mBuffer.size()) return false;
+
+    memcpy(&outValue, mBuffer.data() + mReadOffset, sizeof(T));
+    mReadOffset += sizeof(T);
+    return true;
+}
+
+void InputReplay::flush()
+{
+    mRecordFile.write(reinterpret_cast<const char*>(mBuffer.data()), static_cast<std::streamsize>(mBuffer.size()));
+    mBuffer.clear();
+}
+
+bool InputReplay::startRecording(const char* path)
+{
+    stop();
+
+    mRecordFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!mRecordFile) return false;
+
+    write(sMagic);
+    write(sVersion);
+
+    mMode = InputReplayMode::Recording;
+    mFrameCount = 0;
+    return true;
+}
+
+bool InputReplay::startPlayback(const char* path)
+{
+    stop();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    mBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    mReadOffset = 0;
+
+    char magic[sizeof(sMagic)];
+    uint16_t version = 0;
+    if (!read(magic) || memcmp(magic, sMagic, sizeof(sMagic)) != 0 || !read(version) || version != sVersion)
+    {
+        LOG(Error, "{} is no replay of version {}", path, sVersion);
+        mBuffer.clear();
+        return false;
+    }
+
+    mMode = InputReplayMode::Playing;
+    mFrameCount = 0;
+    return true;
+}
+
+void InputReplay::stop()
+{
+    if (mMode == InputReplayMode::Recording)
+    {
+        flush();
+        mRecordFile.close();
+    }
+
+    mMode = InputReplayMode::Off;
+    mBuffer.clear();
+    mReadOffset = 0;
+    mFrameKeyEvents.clear();
+    mPendingSeeds.clear();
+}
+
+float InputReplay::beginFrame(const float deltaSeconds)
+{
+    if (mMode == InputReplayMode::Recording)
+    {
+        if (mBuffer.size() >= sFlushSize)
+        {
+            flush();
+        }
+
+        write(RecordType::Frame);
+        write(deltaSeconds);
+        ++mFrameCount;
+        return deltaSeconds;
+    }
+
+    if (mMode != InputReplayMode::Playing) return deltaSeconds;
+
+    // Seeds the last frame didn't consume belong to nothing anymore, the worlds would drift apart from here.
+    ensure(mPendingSeeds.empty());
+    mPendingSeeds.clear();
+    mFrameKeyEvents.clear();
+
+    // Only the first frame can have records in front of it, from input routed before the run loop started.
+    if (!mFrameCount)
+    {
+        readEventRecords();
+    }
+
+    RecordType recordType;
+    float recordedDeltaSeconds = 0.f;
+    if (!read(recordType) || recordType != RecordType::Frame || !read(recordedDeltaSeconds))
+    {
+        stop();
+        return deltaSeconds;
+    }
+
+    readEventRecords();
+
+    ++mFrameCount;
+    return recordedDeltaSeconds;
+}
+
+void InputReplay::readEventRecords()
+{
+    // Everything up to the next frame record happened during the current frame.
+    while (mReadOffset < mBuffer.size() && static_cast<RecordType>(mBuffer[mReadOffset]) != RecordType::Frame)
+    {
+        RecordType recordType;
+        read(recordType);
+
+        if (recordType == RecordType::Key)
+        {
+            uint16_t scancode = 0;
+            uint8_t bPressed = 0;
+            if (!read(scancode) || !read(bPressed)) break;
+
+            mFrameKeyEvents.push_back({.scancode = static_cast<SDL_Scancode>(scancode), .bPressed = bPressed != 0});
+        }
+        else if (recordType == RecordType::Seed)
+        {
+            uint32_t seed = 0;
+            if (!read(seed)) break;
+
+            mPendingSeeds.push_back(seed);
+        }
+        else
+        {
+            ensure(false);
+            mReadOffset = mBuffer.size();
+        }
+    }
+}
+
+void InputReplay::routeFrameKeyEvents(InputRouter& inputRouter)
+{
+    for (const KeyEvent& keyEvent : mFrameKeyEvents)
+    {
+        inputRouter.routeKeyEvent(keyEvent.scancode, keyEvent.bPressed);
+    }
+
+    mFrameKeyEvents.clear();
+}
+
+void InputReplay::recordKeyEvent(const SDL_Scancode scancode, const bool bPressed)
+{
+    if (mMode != InputReplayMode::Recording) return;
+
+    write(RecordType::Key);
+    write(static_cast<uint16_t>(scancode));
+    write(static_cast<uint8_t>(bPressed));
+}
+
+uint32_t InputReplay::resolveSeed(const uint32_t seed)
+{
+    if (mMode == InputReplayMode::Recording)
+    {
+        write(RecordType::Seed);
+        write(seed);
+        return seed;
+    }
+
+    if (mMode != InputReplayMode::Playing || !ensure(!mPendingSeeds.empty())) return seed;
+
+    const uint32_t recordedSeed = mPendingSeeds.front();
+    mPendingSeeds.pop_front();
+    return recordedSeed;
+}
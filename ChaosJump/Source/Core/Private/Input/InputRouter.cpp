@@ -2,9 +2,12 @@
 
 #include "Application.h"
 #include "Input/InputReceiverInterface.h"
+#include "Input/InputReplay.h"
 
 void InputRouter::routeKeyEvent(const SDL_Scancode scancode, const bool pressed)
 {
+    Application::getApplication().getInputReplay()->recordKeyEvent(scancode, pressed);
+
     for (InputReceiverInterface* inputReceiver : mAddedInputReceivers)
     {
         mInputReceivers.push_back(inputReceiver);
@@ -0,0 +1,153 @@
+#include "Jobs/JobSystem.h"
+
+#include "Debugging/Profiler.h"
+
+thread_local uint32_t JobSystem::sQueueIndex = 0;
+
+JobSystem::JobSystem(const uint32_t workerCount)
+{
+    mQueues.reserve(workerCount + 1);
+    for (uint32_t i = 0; i < workerCount + 1; ++i)
+    {
+        mQueues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    mWorkers.reserve(workerCount);
+    for (uint32_t i = 1; i < workerCount + 1; ++i)
+    {
+        mWorkers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(mWakeMutex);
+        bRunning = false;
+    }
+    mWakeCondition.notify_all();
+
+    for (std::thread& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t JobSystem::getDefaultWorkerCount()
+{
+    const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void JobSystem::schedule(std::function<void()> function, JobCounter* counter)
+{
+    if (counter)
+    {
+        counter->mPendingJobs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const uint32_t queueIndex = sQueueIndex < mQueues.size() ? sQueueIndex : 0;
+    WorkerQueue& queue = *mQueues[queueIndex];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back({.function = std::move(function), .counter = counter});
+    }
+
+    mQueuedJobCount.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this notify after a worker that just saw an empty queue started waiting.
+    {
+        std::lock_guard lock(mWakeMutex);
+    }
+    mWakeCondition.notify_one();
+}
+
+void JobSystem::wait(const JobCounter& counter)
+{
+    while (!counter.isDone())
+    {
+        if (tryRunJob()) continue;
+
+        // The remaining jobs are running on other threads. Jobs they schedule meanwhile are left to the workers.
+        std::unique_lock lock(mCompletionMutex);
+        mCompletionCondition.wait(lock, [&counter]()
+        {
+            return counter.isDone();
+        });
+    }
+}
+
+bool JobSystem::popJob(const uint32_t queueIndex, Job& outJob)
+{
+    WorkerQueue& queue = *mQueues[queueIndex];
+    std::lock_guard lock(queue.mutex);
+
+    if (queue.jobs.empty()) return false;
+
+    outJob = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::stealJob(const uint32_t thiefIndex, Job& outJob)
+{
+    const uint32_t queueCount = static_cast<uint32_t>(mQueues.size());
+    for (uint32_t offset = 1; offset < queueCount; ++offset)
+    {
+        WorkerQueue& queue = *mQueues[(thiefIndex + offset) % queueCount];
+
+        std::unique_lock lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.jobs.empty()) continue;
+
+        outJob = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+bool JobSystem::tryRunJob()
+{
+    const uint32_t queueIndex = sQueueIndex < mQueues.size() ? sQueueIndex : 0;
+
+    Job job;
+    if (!popJob(queueIndex, job) && !stealJob(queueIndex, job)) return false;
+
+    mQueuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+    runJob(job);
+    return true;
+}
+
+void JobSystem::runJob(Job& job)
+{
+    PROFILE_SCOPE("Job");
+
+    job.function();
+
+    // The counter may be gone as soon as it reads zero, only the JobSystem is touched after the decrement.
+    if (job.counter && job.counter->mPendingJobs.fetch_sub(1, std::memory_order_release) == 1)
+    {
+        {
+            std::lock_guard lock(mCompletionMutex);
+        }
+        mCompletionCondition.notify_all();
+    }
+}
+
+void JobSystem::workerLoop(const uint32_t queueIndex)
+{
+    sQueueIndex = queueIndex;
+    PROFILE_THREAD_NAME("Job Worker");
+
+    while (bRunning)
+    {
+        if (tryRunJob()) continue;
+
+        std::unique_lock lock(mWakeMutex);
+        mWakeCondition.wait(lock, [this]()
+        {
+            return !bRunning || mQueuedJobCount.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
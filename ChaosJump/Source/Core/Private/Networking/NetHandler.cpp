@@ -1,14 +1,21 @@
 ﻿#include "Networking/NetHandler.h"
 
+#include <algorithm>
 #include <chrono>
 #include <string>
 
 #include "Application.h"
+#include "Base/ConsoleVariable.h"
 #include "Debugging/DebugDefinitions.h"
+#include "Debugging/Logger.h"
+#include "Debugging/MemoryTracker.h"
+#include "Debugging/Profiler.h"
 #include "Networking/NetPacket.h"
 #include "Networking/SerializableInterface.h"
 #include "Player/ChaosJumpPlayer.h"
 
+static TConsoleVariable<uint32_t> sReplicationIntervalMilliseconds("net.ReplicationIntervalMs", 4, "Minimum milliseconds between two object replications");
+
 class NetFactory {
     
 public:
@@ -51,7 +58,7 @@ void NetHandler::handleNetPacket(const NetPacket& packet, HSteamNetConnection se
     case HEARTBEAT:
         break;
     case MESSAGE:
-        fprintf(stderr, "[MESSAGE] %s\n", packet.body.c_str());
+        LOG(Info, "[MESSAGE] {}", packet.body);
         break;
     case REMOTEPROCEDURECALL:
         break;
@@ -62,28 +69,29 @@ void NetHandler::handleNetPacket(const NetPacket& packet, HSteamNetConnection se
     }
 }
 
-void printHex(const void* data, size_t size, FILE* out = stdout) {
-    auto* bytes = static_cast<const unsigned char*>(data);
+static void logHex(const void* data, const size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
 
-    for (size_t i = 0; i < size; ++i) {
-        if (i % 16 == 0)
-            fprintf(out, "%04zx: ", i);   // print offset
-        fprintf(out, "%02x ", bytes[i]);  // print byte as 2-digit hex
-        if (i % 16 == 15 || i == size - 1)
-            fprintf(out, "\n");
+    // One record per row, the bytes are only turned into hex on the logging thread.
+    for (size_t offset = 0; offset < size; offset += 16)
+    {
+        LOG(Verbose, "{:04x}: {}", offset, LogHexBytes{std::string_view(bytes + offset, std::min<size_t>(16, size - offset))});
     }
 }
 
 static void logPacket(const NetPacket& packet, HSteamNetConnection receivingConnection)
 {
-    fprintf(stderr, "[OUT MESSAGE TO %u] %d, %u, %d, %u, %llu, %s\n",
+    LOG(Verbose, "[OUT MESSAGE TO {}] {}, {}, {}, {}, {}",
         receivingConnection,
-        packet.header.type,
+        static_cast<int>(packet.header.type),
         packet.header.netGUID,
-        packet.header.objectType,
+        static_cast<int>(packet.header.objectType),
         packet.header.size,
-        packet.header.timestamp,
-        packet.body.c_str());
+        packet.header.timestamp);
+
+    // Serialized bodies are raw memory, as text they would be unreadable.
+    logHex(packet.body.data(), packet.body.size());
 }
 
 void NetHandler::sendPacketToConnection(const NetPacket& packet, const HSteamNetConnection& connection, const bool bReliable)
@@ -92,12 +100,53 @@ void NetHandler::sendPacketToConnection(const NetPacket& packet, const HSteamNet
     SteamNetworkingSockets()->SendMessageToConnection(connection, msg.data(), msg.size(), bReliable ? k_nSteamNetworkingSend_Reliable : k_nSteamNetworkingSend_Unreliable, nullptr);
 }
 
-bool NetHandler::initializeSteam()
+void NetHandler::beginSteamInitialization()
+{
+    if (bSteamInitialized || mSteamInitResult.valid()) return;
+
+    mSteamInitResult = std::async(std::launch::async, []()
+    {
+        return SteamAPI_Init();
+    });
+}
+
+void NetHandler::updateSteamInitialization()
+{
+    if (bSteamInitialized) return;
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (!mSteamInitResult.valid())
+    {
+        if (now >= mNextSteamInitAttempt)
+        {
+            beginSteamInitialization();
+        }
+        return;
+    }
+
+    if (mSteamInitResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+    if (mSteamInitResult.get())
+    {
+        finishSteamInitialization();
+        return;
+    }
+
+    mNextSteamInitAttempt = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(sSteamInitRetrySeconds));
+}
+
+SteamState NetHandler::getSteamState() const
 {
-    if (bSteamInitialized) return true;
-    if (!SteamAPI_Init()) return false;
+    if (bSteamInitialized) return SteamState::Initialized;
+    return mSteamInitResult.valid() ? SteamState::Initializing : SteamState::Unavailable;
+}
 
+void NetHandler::finishSteamInitialization()
+{
     bSteamInitialized = true;
+
+    // Also asynchronous, connections made before the relay network is up just take longer to establish.
     SteamNetworkingUtils()->InitRelayNetworkAccess();
 
     mCallbackConnStatusChanged.Register(this, &NetHandler::handleConnectionStatusChanged);
@@ -105,10 +154,14 @@ bool NetHandler::initializeSteam()
     SteamNetworkingUtils()->SetDebugOutputFunction(k_ESteamNetworkingSocketsDebugOutputType_Msg,
        [](ESteamNetworkingSocketsDebugOutputType, const char* msg)
        {
-           fprintf(stderr, "[SNS] %s\n", msg);
+           LOG(Info, "[SNS] {}", msg);
        });
-    
-    return true;
+
+    // A session hosted while offline becomes joinable now.
+    if (bHosting)
+    {
+        openListenSocket();
+    }
 }
 
 NetHandler::NetHandler() : mListenSocket(0), mPollGroup(0), mServerConnection(0), m_GameRichPresenceJoinRequested(this, &NetHandler::handleGameRichPresenceJoinRequested)
@@ -162,7 +215,7 @@ void NetHandler::handleConnectionStatusChanged(SteamNetConnectionStatusChangedCa
             sockets->CloseConnection(pParam->m_hConn, 0, nullptr, false);
             std::erase(mClientConnections, pParam->m_hConn);
             Application::getApplication().getGameMode()->handleConnectionLeft(pParam->m_hConn);
-            printf("Client disconnected or problem.\n");
+            LOG(Info, "Client disconnected or problem");
         }
         else if (bConnectedAsClient)
         {
@@ -213,8 +266,11 @@ void NetHandler::replicateObject(const SerializableInterface* object) const
 
 void NetHandler::replicateObjects() const
 {
+    PROFILE_FUNCTION();
+    MEMORY_SCOPE(MemoryTag::Networking);
+
     const uint64_t now = SteamNetworkingUtils()->GetLocalTimestamp();
-    if (now - mLastReplicateTimestamp <= mReplicationTickRateMilliseconds*1000) return;
+    if (now - mLastReplicateTimestamp <= sReplicationIntervalMilliseconds.get() * 1000ull) return;
     
     mLastReplicateTimestamp = now;
     for (const SerializableInterface* serializableObject : mNetworkObjects)
@@ -239,6 +295,17 @@ SerializableInterface* NetHandler::createRemoteObject(uint8_t typeId, uint32_t n
 void NetHandler::hostSession()
 {
     if (bHosting) return;
+    bHosting = true;
+
+    // Without Steam the session stays local until Steam finishes initializing, e.g. when replaying headless it never does.
+    if (bSteamInitialized)
+    {
+        openListenSocket();
+    }
+}
+
+void NetHandler::openListenSocket()
+{
     mListenSocket = SteamNetworkingSockets()->CreateListenSocketP2P(mVirtualPort, 0, nullptr);
     mPollGroup = SteamNetworkingSockets()->CreatePollGroup();
 
@@ -247,8 +314,6 @@ void NetHandler::hostSession()
 
     SteamFriends()->SetRichPresence("connect", connect.c_str());
     SteamFriends()->SetRichPresence("status", "Hosting"); 
-
-    bHosting = true;
 }
 
 void NetHandler::closeSession()
@@ -269,7 +334,10 @@ void NetHandler::closeSession()
     mClientConnections.clear();
     mRemotelyCreatedObjects.clear();
 
-    SteamFriends()->ClearRichPresence();
+    if (bSteamInitialized)
+    {
+        SteamFriends()->ClearRichPresence();
+    }
 
     bHosting = false;
 }
@@ -283,19 +351,26 @@ void NetHandler::closeServerConnection()
 
 void NetHandler::openInviteDialogue() const
 {
-    if (!bHosting) return;
+    if (!bHosting || !bSteamInitialized) return;
     
     const uint64 hostId = SteamUser()->GetSteamID().ConvertToUint64();
     const std::string connect = std::to_string(hostId) + ":" + std::to_string(mVirtualPort);
     SteamFriends()->ActivateGameOverlayInviteDialogConnectString(connect.c_str());}
 
-void NetHandler::openFriendslist()
+void NetHandler::openFriendslist() const
 {
+    if (!bSteamInitialized) return;
+
     SteamFriends()->ActivateGameOverlay("Friends");
 }
 
 void NetHandler::receiveMessages() const
 {
+    PROFILE_FUNCTION();
+    MEMORY_SCOPE(MemoryTag::Networking);
+
+    if (!bSteamInitialized) return;
+
     if (bHosting)
     {
         SteamNetworkingMessage_t* msgs[64];
@@ -389,6 +464,10 @@ void NetHandler::handleObjectNetPacket(const NetPacket& packet, const HSteamNetC
 
 void NetHandler::runCallbacks()
 {
+    MEMORY_SCOPE(MemoryTag::Networking);
+
+    if (!bSteamInitialized) return;
+
     SteamAPI_RunCallbacks();
 
     if (bConnectedAsClient)
@@ -19,7 +19,11 @@ Circle::Circle(float radius) : DrawableInterface({.r = 1.f, .g = 0, .b = 0}), mR
     centerVertex.color = {r, g, b, 0};
     centerVertex.tex_coord = {0.f, 0.f};
     
-    mVertices = { centerVertex };
+    std::shared_ptr<RenderMesh> mesh = std::make_shared<RenderMesh>();
+    std::vector<SDL_Vertex>& meshVertices = mesh->vertices;
+    std::vector<int>& meshIndices = mesh->indices;
+
+    meshVertices = { centerVertex };
 
     constexpr int steps = 16;
     constexpr float anglePerStep = 2.f * static_cast<float>((M_PI / steps));
@@ -33,34 +37,26 @@ Circle::Circle(float radius) : DrawableInterface({.r = 1.f, .g = 0, .b = 0}), mR
         SDL_Vertex vertex1 = centerVertex;
         vertex1.position = {xCoord, yCoord};
 
-        mVertices.push_back(vertex1);
+        meshVertices.push_back(vertex1);
 
-        int verticesSize = static_cast<int>(mVertices.size());
+        int verticesSize = static_cast<int>(meshVertices.size());
         if (verticesSize < 3) continue;
 
-        mIndices.push_back(0);
-        mIndices.push_back(verticesSize - 1);
-        mIndices.push_back(verticesSize - 2);
+        meshIndices.push_back(0);
+        meshIndices.push_back(verticesSize - 1);
+        meshIndices.push_back(verticesSize - 2);
     }
+
+    mMesh = std::move(mesh);
 }
 
-void Circle::draw(SDL_Renderer* renderer, const Vector2& viewLocation)
+void Circle::appendRenderItem(RenderPacket& packet, const Vector2& viewLocation) const
 {
-    const auto [r, g, b] = getColor();
-    
-    std::vector translatedVertices = mVertices;
-
-    const Vector2 screenLocation = getScreenLocationForView(viewLocation);
-
-    for(SDL_Vertex& vertex : translatedVertices)
-    {
-        vertex.color = {r, g, b, 0};
-        vertex.position.x += screenLocation.x;
-        vertex.position.y += screenLocation.y;
-    }
-    
-    SDL_RenderGeometry(renderer, nullptr, translatedVertices.data(), static_cast<int>(translatedVertices.size()), mIndices.data(), static_cast<int>(mIndices.size()));
-
+    RenderItem& item = packet.items.emplace_back();
+    item.type = RenderItemType::Geometry;
+    item.screenLocation = getScreenLocationForView(viewLocation);
+    item.color = getColor();
+    item.mesh = mMesh;
 }
 
 bool Circle::shouldBeCulled(const Vector2& viewLocation, const Vector2& windowSize) const
@@ -4,4 +4,8 @@ Platform::Platform() : Rectangle(200, 50)
 {
     setCollisionCategory(CollisionCategory::Ground);
     setCanMove(false);
+    setOneWayPassDirection({.x = 0, .y = -1});
+
+    // Never moves, ticking only refreshes overlaps which can lag a few frames behind.
+    setTickPriority(TickPriority::Low);
 }
\ No newline at end of file
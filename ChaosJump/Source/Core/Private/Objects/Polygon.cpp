@@ -5,7 +5,7 @@
 #include "Physics/CollisionShapes/PolygonShape.h"
 #include "SDL3/SDL_render.h"
 
-Polygon::Polygon(const std::vector<Vector2>& vertices) : DrawableInterface({.r = 0.f, .g = 1.f, .b = 0})
+Polygon::Polygon(const std::span<const Vector2> vertices) : DrawableInterface({.r = 0.f, .g = 1.f, .b = 0})
 {
     const auto [r, g, b] = getColor();
     
@@ -13,7 +13,11 @@ Polygon::Polygon(const std::vector<Vector2>& vertices) : DrawableInterface({.r =
     centerVertex.position = {.x = 0, .y = 0};
     centerVertex.tex_coord = {.x = 0.f, .y = 0.f};
     
-    mVertices = {centerVertex};
+    std::shared_ptr<RenderMesh> mesh = std::make_shared<RenderMesh>();
+    std::vector<SDL_Vertex>& meshVertices = mesh->vertices;
+    std::vector<int>& meshIndices = mesh->indices;
+
+    meshVertices = {centerVertex};
 
     float area = 0.f;
 
@@ -34,39 +38,38 @@ Polygon::Polygon(const std::vector<Vector2>& vertices) : DrawableInterface({.r =
         vertex.position = {vertexVector.x, vertexVector.y};
         vertex.color = {r, g, b};
         vertex.tex_coord = {0.f, 0.f};
-        mVertices.push_back(vertex);
+        meshVertices.push_back(vertex);
 
         if (!i) continue;
 
-        mIndices.push_back(0);   
-        mIndices.push_back(i + 1);   
-        mIndices.push_back(i);
+        meshIndices.push_back(0);   
+        meshIndices.push_back(i + 1);   
+        meshIndices.push_back(i);
     }
 
     setArea(std::abs(area) * 0.5f);
 
-    mIndices.push_back(0);   
-    mIndices.push_back(vertexCount);     
-    mIndices.push_back(1);
+    meshIndices.push_back(0);   
+    meshIndices.push_back(vertexCount);     
+    meshIndices.push_back(1);
+
+    mMesh = std::move(mesh);
     
     setCollisionShape(new PolygonShape(vertices));
 }
 
-void Polygon::draw(SDL_Renderer* renderer, const Vector2& viewLocation)
+const std::vector<Vector2>& Polygon::getVertices() const
 {
-    const auto [r, g, b] = getColor();
-    
-    std::vector translatedVertices = mVertices;
+    return static_cast<const PolygonShape*>(getCollisionShape())->getVertices();
+}
 
-    const Vector2 screenLocation = getScreenLocationForView(viewLocation);
-    for(SDL_Vertex& vertex : translatedVertices)
-    {
-        vertex.color = {r, g, b, 0};
-        vertex.position.x += screenLocation.x;
-        vertex.position.y += screenLocation.y;
-    }
-    
-    SDL_RenderGeometry(renderer, nullptr, translatedVertices.data(), static_cast<int>(translatedVertices.size()), mIndices.data(), static_cast<int>(mIndices.size()));
+void Polygon::appendRenderItem(RenderPacket& packet, const Vector2& viewLocation) const
+{
+    RenderItem& item = packet.items.emplace_back();
+    item.type = RenderItemType::Geometry;
+    item.screenLocation = getScreenLocationForView(viewLocation);
+    item.color = getColor();
+    item.mesh = mMesh;
 }
 
 bool Polygon::shouldBeCulled(const Vector2& viewLocation, const Vector2& windowSize) const
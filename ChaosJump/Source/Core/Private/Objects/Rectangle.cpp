@@ -2,7 +2,7 @@
 
 #include "Physics/CollisionShapes/CircleShape.h"
 #include "Physics/CollisionShapes/RectangleShape.h"
-#include "SDL3/SDL_render.h"
+#include "Render/RenderPacket.h"
 
 Rectangle::Rectangle(const float width, const float height) : DrawableInterface({0, 1, 0}), mWidth(width), mHeight(height)
 {
@@ -11,14 +11,13 @@ Rectangle::Rectangle(const float width, const float height) : DrawableInterface(
     setCollisionShape(new RectangleShape(mRectExtend));
 }
 
-void Rectangle::draw(SDL_Renderer* renderer, const Vector2& viewLocation)
+void Rectangle::appendRenderItem(RenderPacket& packet, const Vector2& viewLocation) const
 {
-    const auto [r, g, b] = getColor();
-    SDL_SetRenderDrawColorFloat(renderer, r, g, b, SDL_ALPHA_OPAQUE);
-
-    const Vector2 screenLocation = getScreenLocationForView(viewLocation);
-    const SDL_FRect positionedRect = {screenLocation.x - mRectExtend.x, screenLocation.y - mRectExtend.y, mWidth, mHeight};
-    SDL_RenderFillRect(renderer, &positionedRect);
+    RenderItem& item = packet.items.emplace_back();
+    item.type = RenderItemType::FilledRect;
+    item.screenLocation = getScreenLocationForView(viewLocation) - mRectExtend;
+    item.color = getColor();
+    item.size = {.x = mWidth, .y = mHeight};
 }
 
 bool Rectangle::shouldBeCulled(const Vector2& viewLocation, const Vector2& windowSize) const
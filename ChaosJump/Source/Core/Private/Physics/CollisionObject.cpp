@@ -6,16 +6,21 @@
 #include <expected>
 
 #include "Application.h"
+#include "Base/FrameArena.h"
 #include "Debugging/DebugDefinitions.h"
+#include "Debugging/DebugDraw.h"
+#include "Debugging/MemoryTracker.h"
+#include "Debugging/Profiler.h"
 #include "Physics/CollisionShapeInterface.h"
 
 std::map<CollisionCategory, std::vector<CollisionObject*>> CollisionObject::sCollisionCategoryBuckets = {};
+uint64_t CollisionObject::sNextBodyId = 1;
 
 std::map<CollisionCategory, CollisionResponseConfig> CollisionObject::sDefaultCollisionResponseConfigs = {
     {
         CollisionCategory::Player,
         {{
-            { CollisionCategory::Ground, CollisionResponse::Overlap },
+            { CollisionCategory::Ground, CollisionResponse::Block },
             { CollisionCategory::Player, CollisionResponse::Block },
             { CollisionCategory::Obstacle, CollisionResponse::Block }
         }}
@@ -46,9 +51,9 @@ const CollisionResponse& CollisionResponseConfig::operator[](CollisionCategory c
     return collisionResponseMap[collisionCategory];
 }
 
-CollisionObject::CollisionObject()
+CollisionObject::CollisionObject() : mBodyId(sNextBodyId++)
 {
-    sCollisionCategoryBuckets[mCollisionCategory].push_back(this);
+    addToBucket();
     mCollisionResponseConfig = sDefaultCollisionResponseConfigs[mCollisionCategory];
 }
 
@@ -72,7 +77,7 @@ Vector2 CollisionObject::getMoveLocation(const float deltaTime) const
     return mVelocity * deltaTime + mLocation;
 }
 
-static Vector2 applyDamping(const Vector2 velocity, const Vector2 dampingPerSecond, const float deltaTime)
+Vector2 applyDamping(const Vector2& velocity, const Vector2& dampingPerSecond, const float deltaTime)
 {
     if (dampingPerSecond.isAlmostZero()) return velocity;
 
@@ -82,6 +87,8 @@ static Vector2 applyDamping(const Vector2 velocity, const Vector2 dampingPerSeco
 
 void CollisionObject::tick(const float deltaTime)
 {
+    MEMORY_SCOPE(MemoryTag::Physics);
+
     updateCollision(deltaTime);
     if (bCanMove)
     {
@@ -122,6 +129,8 @@ struct TScopedValueChange
 
 void CollisionObject::moveTick(float deltaTime)
 {
+    PROFILE_FUNCTION();
+
     constexpr float maxMoveDeltaTime = 1.f;
 
     if (deltaTime > maxMoveDeltaTime)
@@ -137,6 +146,7 @@ void CollisionObject::moveTick(float deltaTime)
     mVelocity = applyDamping(mVelocity, mDampingPerSecond, deltaTime);
 
     mLastMoveFrame = Application::getApplication().getFrameCount();
+    mLastMoveResult = result;
 
     if (!bBlocked)
     {
@@ -188,7 +198,7 @@ void CollisionObject::setCollisionCategory(const CollisionCategory inCollisionCa
     removeFromBucket();
     
     mCollisionCategory = inCollisionCategory;
-    sCollisionCategoryBuckets[mCollisionCategory].push_back(this);
+    addToBucket();
     mCollisionResponseConfig = sDefaultCollisionResponseConfigs[mCollisionCategory];
 }
 
@@ -202,6 +212,11 @@ void CollisionObject::setCanMove(const bool inCanMove)
     bCanMove = inCanMove;
 }
 
+void CollisionObject::setOneWayPassDirection(const Vector2& inPassDirection)
+{
+    mOneWayPassDirection = inPassDirection.getNormalized();
+}
+
 void CollisionObject::setLocation(const Vector2& inLocation)
 {
     mLocation = inLocation;
@@ -240,7 +255,8 @@ CollisionResponse CollisionObject::getCollisionResponseForCategory(const Collisi
 
 void CollisionObject::insertOverlappingObject(CollisionObject* inCollisionObject)
 {
-    mOverlappingObjects.insert(inCollisionObject);
+    if (isOverlappingObject(inCollisionObject)) return;
+    mOverlappingObjects.push_back(inCollisionObject);
 
     //if (inCollisionObject)
     //{
@@ -253,7 +269,7 @@ void CollisionObject::insertOverlappingObject(CollisionObject* inCollisionObject
 
 void CollisionObject::removeOverlappingObject(CollisionObject* inCollisionObject)
 {
-    mOverlappingObjects.erase(inCollisionObject);
+    std::erase(mOverlappingObjects, inCollisionObject);
     //if (inCollisionObject)
     //{
     //    inCollisionObject->mOnDestroyed.unsubscribe(mOverlapDestroyEventIds[inCollisionObject]);
@@ -261,13 +277,40 @@ void CollisionObject::removeOverlappingObject(CollisionObject* inCollisionObject
     //}
 }
 
+bool CollisionObject::isOverlappingObject(const CollisionObject* inCollisionObject) const
+{
+    return std::ranges::find(mOverlappingObjects, inCollisionObject) != mOverlappingObjects.end();
+}
+
+bool CollisionObject::canPassThroughOneWay(const CollisionObject* oneWayObject, const Vector2& collisionNormal) const
+{
+    // Only the side the pass direction points out of is solid.
+    if (collisionNormal.dot(oneWayObject->mOneWayPassDirection) <= 0.f) return true;
+
+    const Vector2 counterVelocity = oneWayObject->bCanMove ? oneWayObject->mVelocity : Vector2{.x = 0.f, .y = 0.f};
+    if ((mVelocity - counterVelocity).dot(collisionNormal) >= 0.f) return true;
+
+    // Already inside before this move means we are halfway through, keep going instead of snagging on the edge.
+    return mCollisionShape->isCollidingWithShapeAtLocation(mLocation, oneWayObject->getCollisionShape(), oneWayObject->getLocation()).bCollided;
+}
+
+void CollisionObject::addToBucket()
+{
+    std::vector<CollisionObject*>& collisionCategoryBucket = sCollisionCategoryBuckets[mCollisionCategory];
+
+    mBucketIndex = static_cast<uint32_t>(collisionCategoryBucket.size());
+    collisionCategoryBucket.push_back(this);
+}
+
 void CollisionObject::removeFromBucket()
 {
-    auto& collisionCategoryBuckets = sCollisionCategoryBuckets[mCollisionCategory];
-    const auto it = std::ranges::find(collisionCategoryBuckets, this);
-    assert(it != collisionCategoryBuckets.end());
+    std::vector<CollisionObject*>& collisionCategoryBucket = sCollisionCategoryBuckets[mCollisionCategory];
+    assert(mBucketIndex < collisionCategoryBucket.size() && collisionCategoryBucket[mBucketIndex] == this);
 
-    collisionCategoryBuckets.erase(it);
+    CollisionObject* lastObject = collisionCategoryBucket.back();
+    lastObject->mBucketIndex = mBucketIndex;
+    collisionCategoryBucket[mBucketIndex] = lastObject;
+    collisionCategoryBucket.pop_back();
 }
 
 void CollisionObject::handleCollision(const CollisionResult& collisionResult)
@@ -276,7 +319,7 @@ void CollisionObject::handleCollision(const CollisionResult& collisionResult)
     
     if (collisionObject)
     {
-        if (mOverlappingObjects.contains(collisionObject)) return;
+        if (isOverlappingObject(collisionObject)) return;
 
         if (bBlocked)
         {
@@ -298,7 +341,7 @@ void CollisionObject::handleCollision(const CollisionResult& collisionResult)
 
 void CollisionObject::updateCollision(const float deltaTime)
 {
-    std::vector<CollisionObject*> stoppedOverlappingObjects = {};
+    TFrameVector<CollisionObject*> stoppedOverlappingObjects;
 
     for (CollisionObject* collisionObject : mOverlappingObjects)
     {
@@ -342,7 +385,7 @@ void CollisionObject::handleCollisionHit(CollisionObject* collisionObject, const
         
     mVelocity = computeElasticCollision(getMass(), counterMass, mVelocity, counterVeloctiy, collisionNormal);
 
-    Application::getApplication().addDebugLine({mLocation, mLocation + collisionNormal * 100, { 0, 1, 0}, 2.f});
+    DEBUG_DRAW_LINE({.start = mLocation, .end = mLocation + collisionNormal * 100, .color = {.r = 0, .g = 1, .b = 0}, .duration = 2.f});
 }
 
 void CollisionObject::handleCollisionBegin(CollisionObject* collisionObject, const Vector2& collisionNormal)
@@ -394,7 +437,7 @@ CollisionResult CollisionObject::getCollisionResultOnLocation(const Vector2& inL
     const auto& CollisionResponseConfig = sDefaultCollisionResponseConfigs[mCollisionCategory];
 
 
-    std::vector<const std::vector<CollisionObject*>*> collidableBucketsPtrs;
+    TFrameVector<const std::vector<CollisionObject*>*> collidableBucketsPtrs;
     for (const auto& [collisionCategory, collisionResponse] : CollisionResponseConfig)
     {
         if (collisionResponse != CollisionResponse::Ignore)
@@ -413,7 +456,13 @@ CollisionResult CollisionObject::getCollisionResultOnLocation(const Vector2& inL
             result = mCollisionShape->isCollidingWithShapeAtLocation(inLocation, collisionObject->getCollisionShape(), collisionObject->getLocation());
             if (result.bCollided)
             {
-                result.bBlocked = CollisionResponse::Block == mCollisionResponseConfig[collisionObject->getCollisionCategory()] && !mOverlappingObjects.contains(collisionObject);
+                if (collisionObject->isOneWay() && canPassThroughOneWay(collisionObject, result.collisionNormal))
+                {
+                    result = {};
+                    continue;
+                }
+
+                result.bBlocked = CollisionResponse::Block == mCollisionResponseConfig[collisionObject->getCollisionCategory()] && !isOverlappingObject(collisionObject);
                 return result;
             }
         }
@@ -2,6 +2,7 @@
 
 #include "Application.h"
 #include "Debugging/DebugDefinitions.h"
+#include "Debugging/DebugDraw.h"
 #include "Physics/CollisionShapes/PolygonShape.h"
 #include "Physics/CollisionShapes/CircleShape.h"
 #include "Physics/CollisionShapes/RectangleShape.h"
@@ -43,7 +44,7 @@ CollisionResult CollisionShapeInterface::getCollisionResultForShapes(const Polyg
 
     result.bCollided = true;
     
-    std::vector<Vector2> normals;
+    TFrameVector<Vector2> normals;
     shape->getNormals(normals);
     otherShape->getNormals(normals);
 
@@ -60,8 +61,7 @@ CollisionResult CollisionShapeInterface::getCollisionResultForShapes(const Polyg
         Application& application = Application::getApplication();
 
         const Vector2 windowCenter = application.getWindowSize() / 2;
-        const DebugLine debugLine = {.start = windowCenter + normal * min, .end = windowCenter + normal * max, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}};
-        application.addDebugLine(debugLine);
+        DEBUG_DRAW_LINE({.start = windowCenter + normal * min, .end = windowCenter + normal * max, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}});
 #endif
         
         if (!bColliding)
@@ -107,15 +107,13 @@ CollisionResult CollisionShapeInterface::getCollisionResultForShapes(const Polyg
 
     result.bCollided = true;
     
-    std::vector<Vector2> normals;
+    TFrameVector<Vector2> normals;
     shape->getNormals(normals);
 
     normals.push_back((shape->getVertexClosestToRelativeLocation(otherLocation - shapeLocation) - otherLocation).getNormalized());
 
     float smallestEdgeDistance = std::numeric_limits<float>::max();
 
-    Application& application = Application::getApplication();
-    
     for (const Vector2& normal : normals)
     {
         auto [min, max] = shape->getExtremesOnNormal(shapeLocation, normal);
@@ -128,12 +126,8 @@ CollisionResult CollisionShapeInterface::getCollisionResultForShapes(const Polyg
         const bool bColliding = !(otherMax < min || max < otherMin);
 
 #if DEBUG_SAT_CIRCLE_COLLISION
-
-        const DebugLine debugLineC = {.start = normal * otherMin, .end = normal * otherMax, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}};
-        application.addDebugLine(debugLineC);
-
-        const DebugLine debugLineP = {.start = normal * min, .end = normal * max, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}};
-        application.addDebugLine(debugLineP);
+        DEBUG_DRAW_LINE({.start = normal * otherMin, .end = normal * otherMax, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}});
+        DEBUG_DRAW_LINE({.start = normal * min, .end = normal * max, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}});
 #endif
         
         if (!bColliding)
@@ -207,11 +201,7 @@ CollisionResult CollisionShapeInterface::getCollisionResultForShapes(const Recta
         result.collisionNormal = {.x = 0.f, .y = (deltaY < 0) ? 1.f : -1.f}; 
     }
 
-
-    Application& application = Application::getApplication();
-
-    const DebugLine debugLine = {.start = otherLocation, .end = otherLocation + result.collisionNormal * 100, .color = {.r = 1.f, .g = 0.f, .b = 0.5f}};
-    application.addDebugLine(debugLine);
+    DEBUG_DRAW_LINE({.start = otherLocation, .end = otherLocation + result.collisionNormal * 100, .color = {.r = 1.f, .g = 0.f, .b = 0.5f}});
 
     return result;
 }
@@ -222,7 +212,7 @@ CollisionResult CollisionShapeInterface::getCollisionResultForShapes(const Recta
     CollisionResult result;
     result.bCollided = true;
 
-    std::vector<Vector2> normals;
+    TFrameVector<Vector2> normals;
     otherShape->getNormals(normals);
 
     normals.push_back({1.f, 0.f});
@@ -266,10 +256,8 @@ CollisionResult CollisionShapeInterface::getCollisionResultForShapes(const Recta
 #if DEBUG_SAT_RECTANGLE_COLLISION
         Application& application = Application::getApplication();
         const Vector2 windowCenter = application.getWindowSize() / 2;
-        const DebugLine debugLine = {.start = windowCenter + normal * minRect, .end = windowCenter + normal * maxRect, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}};
-        const DebugLine debugLine2 = {.start = normal * minPoly, .end = normal * maxPoly, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}};
-        application.addDebugLine(debugLine);
-        application.addDebugLine(debugLine2);
+        DEBUG_DRAW_LINE({.start = windowCenter + normal * minRect, .end = windowCenter + normal * maxRect, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}});
+        DEBUG_DRAW_LINE({.start = normal * minPoly, .end = normal * maxPoly, .color = {.r = 1.f * bColliding, .g = 0.f, .b = 0.5f}});
 #endif
 
         if (!bColliding)
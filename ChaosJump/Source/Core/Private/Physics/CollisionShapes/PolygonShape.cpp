@@ -35,7 +35,7 @@ Vector2 PolygonShape::getVertexClosestToRelativeLocation(const Vector2& location
     return closestVertex;
 }
 
-void PolygonShape::getNormals(std::vector<Vector2>& outNormals) const
+void PolygonShape::getNormals(TFrameVector<Vector2>& outNormals) const
 {
     if (!mNormalCache.empty())
     {
@@ -81,7 +81,7 @@ PolygonShape::Extremes PolygonShape::getExtremesOnNormal(const Vector2& location
     return extremes;
 }
 
-PolygonShape::PolygonShape(const std::vector<Vector2>& vertices) : CollisionShapeInterface(2), mVertices(vertices)
+PolygonShape::PolygonShape(const std::span<const Vector2> vertices) : CollisionShapeInterface(2), mVertices(vertices.begin(), vertices.end())
 {
 }
 
@@ -0,0 +1,182 @@
+#include "Physics/PhysicsSnapshot.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "Physics/CollisionObject.h"
+
+static constexpr CollisionCategory sSnapshotCategories[] = { CollisionCategory::Ground, CollisionCategory::Obstacle, CollisionCategory::Player };
+
+static uint32_t getCategoryIndex(const CollisionCategory category)
+{
+    return std::countr_zero(static_cast<uint32_t>(category));
+}
+
+void PhysicsSnapshot::capture()
+{
+    mBodyStates.clear();
+    mOverlaps.clear();
+
+    for (const auto& [collisionCategory, bucket] : CollisionObject::sCollisionCategoryBuckets)
+    {
+        for (CollisionObject* body : bucket)
+        {
+            BodyState& state = mBodyStates.emplace_back();
+            state.body = body;
+            state.bodyId = body->mBodyId;
+            state.location = body->mLocation;
+            state.velocity = body->mVelocity;
+            state.gravity = body->mGravity;
+            state.dampingPerSecond = body->mDampingPerSecond;
+            state.oneWayPassDirection = body->mOneWayPassDirection;
+            state.area = body->mArea;
+            state.density = body->mDensity;
+            state.lastMoveFrame = body->mLastMoveFrame;
+            state.category = body->mCollisionCategory;
+            state.bCanMove = body->bCanMove;
+            state.bCollideWindowX = body->bCollideWindowX;
+            state.bCollideWindowY = body->bCollideWindowY;
+
+            for (const auto& [responseCategory, response] : body->mCollisionResponseConfig)
+            {
+                state.collisionResponses[getCategoryIndex(responseCategory)] = static_cast<uint8_t>(response);
+            }
+
+            state.overlapBegin = static_cast<uint32_t>(mOverlaps.size());
+            state.overlapCount = static_cast<uint32_t>(body->mOverlappingObjects.size());
+            for (CollisionObject* overlappingObject : body->mOverlappingObjects)
+            {
+                mOverlaps.push_back({.body = overlappingObject, .bodyId = overlappingObject ? overlappingObject->mBodyId : 0});
+            }
+        }
+    }
+
+    bBodyLookupDirty = true;
+}
+
+void PhysicsSnapshot::restore() const
+{
+    const size_t bodyCount = mBodyStates.size();
+
+    // Usual case for rollback: nothing was spawned or destroyed since the capture, so the buckets line up with the states.
+    bool bAligned = true;
+    size_t liveBodyCount = 0;
+    for (const auto& [collisionCategory, bucket] : CollisionObject::sCollisionCategoryBuckets)
+    {
+        for (const CollisionObject* body : bucket)
+        {
+            if (liveBodyCount >= bodyCount || mBodyStates[liveBodyCount].body != body || mBodyStates[liveBodyCount].bodyId != body->mBodyId)
+            {
+                bAligned = false;
+                break;
+            }
+            ++liveBodyCount;
+        }
+
+        if (!bAligned) break;
+    }
+
+    if (bAligned && liveBodyCount == bodyCount)
+    {
+        for (const BodyState& state : mBodyStates)
+        {
+            applyBodyState(state, false);
+        }
+        return;
+    }
+
+    mLiveBodies.clear();
+    for (const auto& [collisionCategory, bucket] : CollisionObject::sCollisionCategoryBuckets)
+    {
+        for (const CollisionObject* body : bucket)
+        {
+            mLiveBodies.emplace_back(body, body->mBodyId);
+        }
+    }
+    std::ranges::sort(mLiveBodies);
+
+    if (bBodyLookupDirty)
+    {
+        mBodyLookup.clear();
+        for (uint32_t i = 0; i < bodyCount; ++i)
+        {
+            mBodyLookup.emplace_back(mBodyStates[i].body, i);
+        }
+        std::ranges::sort(mBodyLookup);
+        bBodyLookupDirty = false;
+    }
+
+    for (const auto& [body, bodyId] : mLiveBodies)
+    {
+        if (const BodyState* state = findBodyState(body))
+        {
+            applyBodyState(*state, true);
+        }
+    }
+}
+
+void PhysicsSnapshot::clear()
+{
+    mBodyStates.clear();
+    mOverlaps.clear();
+    mBodyLookup.clear();
+    bBodyLookupDirty = true;
+}
+
+size_t PhysicsSnapshot::getByteSize() const
+{
+    return mBodyStates.size() * sizeof(BodyState) + mOverlaps.size() * sizeof(OverlapState);
+}
+
+const PhysicsSnapshot::BodyState* PhysicsSnapshot::findBodyState(const CollisionObject* body) const
+{
+    const auto it = std::ranges::lower_bound(mBodyLookup, body, {}, &std::pair<const CollisionObject*, uint32_t>::first);
+    if (it == mBodyLookup.end() || it->first != body) return nullptr;
+
+    // Same address but a newer body, the captured one was destroyed and its pool slot reused.
+    const BodyState& state = mBodyStates[it->second];
+    return state.bodyId == body->mBodyId ? &state : nullptr;
+}
+
+bool PhysicsSnapshot::isBodyAlive(const OverlapState& overlap) const
+{
+    return std::ranges::binary_search(mLiveBodies, std::pair<const CollisionObject*, uint64_t>(overlap.body, overlap.bodyId));
+}
+
+void PhysicsSnapshot::applyBodyState(const BodyState& state, const bool bValidateOverlaps) const
+{
+    CollisionObject* body = state.body;
+
+    body->mLocation = state.location;
+    body->mVelocity = state.velocity;
+    body->mGravity = state.gravity;
+    body->mDampingPerSecond = state.dampingPerSecond;
+    body->mOneWayPassDirection = state.oneWayPassDirection;
+    body->mArea = state.area;
+    body->mDensity = state.density;
+    body->mLastMoveFrame = state.lastMoveFrame;
+    body->bCanMove = state.bCanMove;
+    body->bCollideWindowX = state.bCollideWindowX;
+    body->bCollideWindowY = state.bCollideWindowY;
+
+    if (body->mCollisionCategory != state.category)
+    {
+        body->removeFromBucket();
+        body->mCollisionCategory = state.category;
+        body->addToBucket();
+    }
+
+    for (const CollisionCategory category : sSnapshotCategories)
+    {
+        body->mCollisionResponseConfig[category] = static_cast<CollisionResponse>(state.collisionResponses[getCategoryIndex(category)]);
+    }
+
+    body->mOverlappingObjects.clear();
+    for (uint32_t i = 0; i < state.overlapCount; ++i)
+    {
+        const OverlapState& overlap = mOverlaps[state.overlapBegin + i];
+        if (bValidateOverlaps && overlap.body && !isBodyAlive(overlap)) continue;
+
+        body->mOverlappingObjects.push_back(overlap.body);
+    }
+}
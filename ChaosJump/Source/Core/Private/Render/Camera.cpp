@@ -7,7 +7,7 @@ void Camera::setCameraHeight(const float inHeight)
     mCameraLocation.y = inHeight;
 }
 
-Camera::Camera(const Vector2& inFollowOffset, CollisionObject* inFollowingObject) : mFollowOffset(inFollowOffset), mFollowingObject(inFollowingObject)
+Camera::Camera(const Vector2& inFollowOffset, CollisionObject* inFollowingObject) : TickableInterface(TickPhase::Late), mFollowOffset(inFollowOffset), mFollowingObject(inFollowingObject)
 {
 }
 
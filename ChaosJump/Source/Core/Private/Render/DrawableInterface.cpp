@@ -1,11 +1,11 @@
-#include <algorithm>
-
 #include "Render/DrawableInterface.h"
 
 std::vector<DrawableInterface*> DrawableInterface::sDrawables = {};
+bool DrawableInterface::bDrawablesHaveHoles = false;
 
 DrawableInterface::DrawableInterface(Color color) : mColor(color)
 {
+    mDrawableIndex = static_cast<uint32_t>(sDrawables.size());
     sDrawables.push_back(this);
 }
 
@@ -16,6 +16,23 @@ void DrawableInterface::setColor(Color color)
 
 DrawableInterface::~DrawableInterface()
 {
-    auto it = std::ranges::find(sDrawables, this);
-    sDrawables.erase(it);
+    sDrawables[mDrawableIndex] = nullptr;
+    bDrawablesHaveHoles = true;
+}
+
+void DrawableInterface::compactDrawables()
+{
+    if (!bDrawablesHaveHoles) return;
+
+    uint32_t writeIndex = 0;
+    for (DrawableInterface* drawable : sDrawables)
+    {
+        if (!drawable) continue;
+
+        drawable->mDrawableIndex = writeIndex;
+        sDrawables[writeIndex++] = drawable;
+    }
+
+    sDrawables.resize(writeIndex);
+    bDrawablesHaveHoles = false;
 }
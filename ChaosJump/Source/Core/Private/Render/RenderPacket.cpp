@@ -0,0 +1,11 @@
+#include "Render/RenderPacket.h"
+
+void RenderPacket::reset()
+{
+    items.clear();
+    debugLines.clear();
+    displayTexts.clear();
+    frameTimeGraph.clear();
+    frameTimeGraphReferences.clear();
+    viewLocation = {};
+}
@@ -0,0 +1,198 @@
+#include "Render/TextCache.h"
+
+#include "Debugging/Logger.h"
+#include "SDL3/SDL.h"
+
+static float getTextWidth(const std::string& text)
+{
+    return static_cast<float>(SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE * SDL_strlen(text.c_str()));
+}
+
+/* Top left corner of the text in units of its scale */
+static Vector2 getTextOrigin(const DisplayText& displayText, const Vector2& windowSize)
+{
+    const Vector2 windowCenter = windowSize / 2 / displayText.textScale;
+    const Vector2 position = windowCenter + windowCenter * displayText.screenPosition;
+
+    const float halfTextWidth = getTextWidth(displayText.text) / 2;
+    const float halfTextHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE / 2.f;
+
+    return {
+        .x = position.x - halfTextWidth - displayText.alignment.x * halfTextWidth,
+        .y = position.y - halfTextHeight - displayText.alignment.y * halfTextHeight
+    };
+}
+
+static void drawTextDirectly(SDL_Renderer* renderer, const DisplayText& displayText, const Vector2& windowSize)
+{
+    const auto& [screenPosition, text, color, duration, textScale, alignment] = displayText;
+    const Vector2 origin = getTextOrigin(displayText, windowSize);
+
+    SDL_SetRenderDrawColor(renderer, color.r * 255, color.g * 255, color.b * 255, 255);
+    SDL_SetRenderScale(renderer, textScale.x, textScale.y);
+    SDL_RenderDebugText(renderer, origin.x, origin.y, text.c_str());
+    SDL_SetRenderScale(renderer, 1.f, 1.f);
+}
+
+TextCache::TextCache(SDL_Renderer* renderer) : mRenderer(renderer)
+{
+    mAtlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, sAtlasWidth, sAtlasHeight);
+    if (!mAtlas)
+    {
+        LOG(Warning, "Text atlas unavailable, texts are drawn uncached: {}", SDL_GetError());
+        return;
+    }
+
+    SDL_SetTextureBlendMode(mAtlas, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(mAtlas, SDL_SCALEMODE_NEAREST);
+}
+
+TextCache::~TextCache()
+{
+    if (mAtlas)
+    {
+        SDL_DestroyTexture(mAtlas);
+    }
+}
+
+bool TextCache::allocate(const float width, SDL_FRect& outRect)
+{
+    if (mCursorX + width > sAtlasWidth)
+    {
+        mCursorX = 0.f;
+        mCursorY += sRowHeight;
+    }
+
+    if (mCursorY + sRowHeight > sAtlasHeight) return false;
+
+    outRect = {.x = mCursorX, .y = mCursorY, .w = width, .h = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE};
+    mCursorX += width + 1;
+    return true;
+}
+
+void TextCache::cacheTexts(const std::vector<DisplayText>& texts)
+{
+    mPendingEntries.clear();
+
+    // The second attempt starts from an empty atlas, whatever still doesn't fit then is drawn directly.
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        bool bAtlasFull = false;
+
+        for (const DisplayText& displayText : texts)
+        {
+            const std::string& text = displayText.text;
+            if (text.empty() || mEntries.contains(text)) continue;
+
+            const float width = getTextWidth(text);
+            if (width > sAtlasWidth) continue;
+
+            SDL_FRect rect;
+            if (!allocate(width, rect))
+            {
+                bAtlasFull = true;
+                break;
+            }
+
+            mPendingEntries.push_back(&*mEntries.emplace(text, rect).first);
+        }
+
+        if (!bAtlasFull || attempt > 0) return;
+
+        clear();
+    }
+}
+
+void TextCache::rasterizePendingEntries()
+{
+    if (mPendingEntries.empty()) return;
+
+    SDL_SetRenderTarget(mRenderer, mAtlas);
+
+    if (bAtlasDirty)
+    {
+        SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
+        SDL_RenderClear(mRenderer);
+        bAtlasDirty = false;
+    }
+
+    SDL_SetRenderDrawColor(mRenderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+    for (const EntryMap::value_type* entry : mPendingEntries)
+    {
+        const auto& [text, rect] = *entry;
+        SDL_RenderDebugText(mRenderer, rect.x, rect.y, text.c_str());
+    }
+
+    SDL_SetRenderTarget(mRenderer, nullptr);
+    mPendingEntries.clear();
+}
+
+void TextCache::clear()
+{
+    mEntries.clear();
+    mPendingEntries.clear();
+    mCursorX = 0.f;
+    mCursorY = 0.f;
+    bAtlasDirty = true;
+}
+
+void TextCache::drawTexts(const std::vector<DisplayText>& texts, const Vector2& windowSize)
+{
+    if (texts.empty()) return;
+
+    if (!mAtlas)
+    {
+        for (const DisplayText& displayText : texts)
+        {
+            drawTextDirectly(mRenderer, displayText, windowSize);
+        }
+        return;
+    }
+
+    cacheTexts(texts);
+    rasterizePendingEntries();
+
+    mVertices.clear();
+    mIndices.clear();
+
+    for (const DisplayText& displayText : texts)
+    {
+        const auto entry = mEntries.find(displayText.text);
+        if (entry == mEntries.end()) continue;
+
+        const SDL_FRect& atlasRect = entry->second;
+        const Vector2& textScale = displayText.textScale;
+        const Vector2 origin = getTextOrigin(displayText, windowSize) * textScale;
+        const Vector2 size = Vector2{.x = atlasRect.w, .y = atlasRect.h} * textScale;
+
+        const float u0 = atlasRect.x / sAtlasWidth;
+        const float v0 = atlasRect.y / sAtlasHeight;
+        const float u1 = (atlasRect.x + atlasRect.w) / sAtlasWidth;
+        const float v1 = (atlasRect.y + atlasRect.h) / sAtlasHeight;
+
+        const SDL_FColor color = {.r = displayText.color.r, .g = displayText.color.g, .b = displayText.color.b, .a = 1.f};
+        const int firstVertex = static_cast<int>(mVertices.size());
+
+        mVertices.push_back({.position = {.x = origin.x, .y = origin.y}, .color = color, .tex_coord = {.x = u0, .y = v0}});
+        mVertices.push_back({.position = {.x = origin.x + size.x, .y = origin.y}, .color = color, .tex_coord = {.x = u1, .y = v0}});
+        mVertices.push_back({.position = {.x = origin.x + size.x, .y = origin.y + size.y}, .color = color, .tex_coord = {.x = u1, .y = v1}});
+        mVertices.push_back({.position = {.x = origin.x, .y = origin.y + size.y}, .color = color, .tex_coord = {.x = u0, .y = v1}});
+
+        for (const int corner : {0, 1, 2, 0, 2, 3})
+        {
+            mIndices.push_back(firstVertex + corner);
+        }
+    }
+
+    if (!mIndices.empty())
+    {
+        SDL_RenderGeometry(mRenderer, mAtlas, mVertices.data(), static_cast<int>(mVertices.size()), mIndices.data(), static_cast<int>(mIndices.size()));
+    }
+
+    // Only texts wider than the atlas or more than fit into an empty one end up here.
+    for (const DisplayText& displayText : texts)
+    {
+        if (displayText.text.empty() || mEntries.contains(displayText.text)) continue;
+        drawTextDirectly(mRenderer, displayText, windowSize);
+    }
+}
@@ -1,16 +1,23 @@
 #pragma once
 #include <memory>
-#include <set>
+#include <string>
 #include <vector>
 
 #include "Base/HelperDefinitions.h"
+#include "Base/TickableInterface.h"
+#include "Debugging/FrameTracker.h"
 #include "Game/GameMode.h"
 #include "Input/InputRouter.h"
 #include "Math/Vector2.h"
 #include "Render/Camera.h"
 #include "Render/DrawableInterface.h"
+#include "Render/RenderPacket.h"
 
 class NetHandler;
+class JobSystem;
+class EntityStore;
+class InputReplay;
+class TextCache;
 class ChaosJumpGameMode;
 class CollisionShapeInterface;
 class SDL_Window;
@@ -19,6 +26,14 @@ class InputRouter;
 class NetHandler;
 union SDL_Event;
 
+/* Values match the interval passed to SDL_SetRenderVSync */
+enum class PresentMode : int8_t
+{
+    Immediate = 0,
+    VSync = 1,
+    AdaptiveVSync = -1
+};
+
 struct ApplicationParams
 {
 
@@ -26,60 +41,72 @@ struct ApplicationParams
     int width = 1280;
     int height = 720;
     const char* renderDriver = "opengl";
-    // 0 unlimits FPS
+    // 0 unlimits FPS, otherwise frames are paced to this rate on top of the present mode
     uint32_t framesPerSecond = 60;
+    PresentMode presentMode = PresentMode::Immediate;
 
     bool bDrawFPS = true;
-    
-};
 
-struct DebugLine
-{
-    Vector2 start;
-    Vector2 end;
-    Color color;
-    float duration = 0.f;
-};
+    // -1 spawns a worker for every spare hardware thread, 0 runs jobs on the main thread only
+    int32_t workerThreadCount = -1;
 
-struct DisplayText
-{
-    /*TopLeft window border = {-1, -1}, bottom right = {1, 1}*/
-    Vector2 screenPosition = {};
-    std::string text;
-    Color color = {1, 1, 1};
-    float duration = 0.f;
-    Vector2 textScale = {1, 1}; 
+    // Ticks frame N+1 on a worker while the main thread renders frame N, adds a frame of latency
+    bool bPipelineRendering = true;
+
+    bool bDrawFrameTimeGraph = false;
+
+    // Frame stats are written here on exit, .json for window percentiles, anything else for a CSV of the buffered frames
+    const char* frameStatsPath = nullptr;
+
+    // No window, renderer, input or Steam, frames run back to back without pacing or pipelining
+    bool bHeadless = false;
+
+    // Simulates every frame with this delta instead of the measured frame time, 0 measures.
+    // Low priority tickables also tick without a time budget then, so a fixed seed reproduces the run.
+    float fixedDeltaSeconds = 0.f;
+
+    // run() returns after this many frames, 0 runs until quit
+    uint64_t maxFrameCount = 0;
+
+    // Phase timings and peak object counts are written here as JSON when run() returns
+    const char* benchmarkReportPath = nullptr;
+
+    // Records the session into this replay, ignored while one is played
+    const char* recordReplayPath = nullptr;
+
+    // Plays this replay instead of live input, a headless run ends with the replay
+    const char* playReplayPath = nullptr;
     
-    /* TopLeft Text border = {-1, -1}, bottom right = {1, 1}
-     * This is the position in the DisplayText that aligns with the screenPosition.
-     */
-    Vector2 alignment = {};
 };
 
-class FrameTracker
+/* Schedules frame deadlines on the performance counter, sleeps most of the remaining time and spins the rest. */
+class FramePacer
 {
-    
+
 private:
-    float mTotalFrameTime = 0.f;
-    uint64_t mFrameCounter = 0;
-    
-    float lastFrameTime = 0.f;
-    mutable std::multiset<float> mFrameTimes = {};
-    
+
+    uint64_t mFrameTicks = 0;
+    uint64_t mSpinTicks = 0;
+    uint64_t mNextFrameDeadline = 0;
+
 public:
 
-    uint64_t getFrameCounter() const { return mFrameCounter; }
-    
-    void pushFrameTime(float frameTime);
+    void setTargetFPS(uint32_t framesPerSecond);
 
-    float getCurrentFPS() const;
-    float getAverageFPS() const;
+    void waitForNextFrame();
 
-    /**
-     * \param fraction expects value 0-1
-     */
-    float getLowestPercentageFPS(float fraction) const;
-    
+};
+
+/* Sampled every frame while a benchmark report is requested */
+struct ObjectCounts
+{
+    uint32_t tickables[static_cast<size_t>(TickPhase::Count)] = {};
+    uint32_t drawables = 0;
+    uint32_t entities = 0;
+    std::vector<ObjectCount> gameCounts = {};
+
+    /* Keeps the larger value of every count, game counts are matched by name */
+    void mergeMax(const ObjectCounts& other);
 };
 
 struct WindowDeleter
@@ -94,6 +121,10 @@ struct RendererDeleter
 };
 
 DECLARE_DEFAULT_DELETER(NetHandler)
+DECLARE_DEFAULT_DELETER(JobSystem)
+DECLARE_DEFAULT_DELETER(EntityStore)
+DECLARE_DEFAULT_DELETER(InputReplay)
+DECLARE_DEFAULT_DELETER(TextCache)
 
 class Application
 {
@@ -101,26 +132,53 @@ private:
 
     std::unique_ptr<SDL_Window, WindowDeleter> mWindow = nullptr;
     std::unique_ptr<SDL_Renderer, RendererDeleter> mRenderer = nullptr;
+    std::unique_ptr<TextCache, TextCacheDeleter> mTextCache = nullptr;
 
     std::unique_ptr<InputRouter> mInputRouter = nullptr;
     std::unique_ptr<GameMode> mGameMode = nullptr;
     std::unique_ptr<NetHandler, NetHandlerDeleter> mNetHandler = nullptr;
+    std::unique_ptr<JobSystem, JobSystemDeleter> mJobSystem = nullptr;
+    std::unique_ptr<EntityStore, EntityStoreDeleter> mEntityStore = nullptr;
+    std::unique_ptr<InputReplay, InputReplayDeleter> mInputReplay = nullptr;
     std::weak_ptr<Camera> mRenderCamera;
     
     bool bRunning = false;
 
-    /* measured in ms */
-    uint32_t mFrameTime = 16;
+    FramePacer mFramePacer = {};
     Vector2 mWindowSize;
 
-    bool bDrawFPS = true;
+    bool bDrawFrameTimeGraph = false;
+    const char* mFrameStatsPath = nullptr;
+
+    bool bHeadless = false;
+    float mFixedDeltaSeconds = 0.f;
+    uint64_t mMaxFrameCount = 0;
+    const char* mBenchmarkReportPath = nullptr;
+
+    ObjectCounts mObjectCounts = {};
+    ObjectCounts mPeakObjectCounts = {};
+
+    /* Measured against the final world of a benchmark run */
+    uint32_t mSnapshotBodyCount = 0;
+    float mSnapshotCaptureSeconds = 0.f;
+    float mSnapshotRestoreSeconds = 0.f;
 
     static ApplicationParams sApplicationParams;
 
     FrameTracker mFrameTracker = {};
-    std::vector<DebugLine> mDebugLines = {};
     std::vector<DisplayText> mDisplayTexts = {};
 
+    bool bPipelineRendering = true;
+
+    /* Toggled with the key below escape, swallows key presses while open and executes console variable commands */
+    bool bConsoleOpen = false;
+    std::string mConsoleInput = {};
+
+    /* One packet is filled by the simulation while the other one gets rendered */
+    RenderPacket mRenderPackets[2] = {};
+    std::vector<SDL_Vertex> mTranslatedVertices = {};
+    std::vector<float> mRecentFrameTimes = {};
+
 protected:
     
     Application() = default;
@@ -136,8 +194,12 @@ public:
     void setGameMode(std::unique_ptr<GameMode> gameMode);
     
     NetHandler* getNetHandler() const { return mNetHandler.get(); }
+    JobSystem* getJobSystem() const { return mJobSystem.get(); }
+    EntityStore* getEntityStore() const { return mEntityStore.get(); }
+    InputReplay* getInputReplay() const { return mInputReplay.get(); }
 
     uint64_t getFrameCount() const { return mFrameTracker.getFrameCounter(); }
+    const FrameTracker& getFrameTracker() const { return mFrameTracker; }
 
     static Application& initApplication(const ApplicationParams& params);
     
@@ -146,7 +208,7 @@ public:
     void run();
 
     const Vector2& getWindowSize() const { return mWindowSize; }
-    void addDebugLine(const DebugLine& debugLine);
+    bool isHeadless() const { return bHeadless; }
     void addDisplayText(const DisplayText& displayText);
     Vector2 getCurrentViewLocation() const;
     void setRenderCamera(std::weak_ptr<Camera> inCamera);
@@ -155,8 +217,22 @@ public:
     
 protected:
 
-    void drawFrame(float deltaTime);
+    /* Low priority tickables aren't budgeted here, the whole group is spread across the job system */
+    void tickParallelGroup(const std::vector<TickableInterface*>& tickGroup, float deltaSeconds) const;
+    void extractRenderPacket(RenderPacket& packet, float deltaTime);
+    void extractFrameTimeGraph(RenderPacket& packet);
+    void collectObjectCounts(ObjectCounts& outCounts) const;
+    /* Averages PhysicsSnapshot capture and restore of the live world, restoring right after capturing changes nothing */
+    void measurePhysicsSnapshot();
+    bool writeBenchmarkReport(const char* path) const;
+    void drawFrame(const RenderPacket& packet);
     void pollEvents();
     void handleEvent(const SDL_Event& event);
+
+    void setConsoleOpen(bool bOpen);
+    void handleConsoleKeyPressed(SDL_Scancode scancode);
+
+    /* Starts a profiler capture or writes the running one to ProfileTrace.json */
+    void toggleProfilerCapture();
     
 };
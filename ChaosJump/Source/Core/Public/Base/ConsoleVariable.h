@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Base/Delegate.h"
+
+/*
+ * Named value that can be changed at runtime from a config file, the command line or the in-game console.
+ * Variables are static objects next to the code reading them, they link themselves into a list on construction.
+ */
+class ConsoleVariable
+{
+
+private:
+
+    const char* mName = nullptr;
+    const char* mDescription = nullptr;
+    ConsoleVariable* mNext = nullptr;
+
+    TDelegate<void()> mOnChanged;
+
+    /* A function local head so variables of other translation units can register during static initialization */
+    static ConsoleVariable*& getHead();
+
+protected:
+
+    ConsoleVariable(const char* name, const char* description);
+
+    virtual bool parseValue(std::string_view text) = 0;
+
+    void notifyChanged() const;
+
+public:
+
+    ConsoleVariable(const ConsoleVariable&) = delete;
+    ConsoleVariable& operator=(const ConsoleVariable&) = delete;
+
+    virtual ~ConsoleVariable() = default;
+
+    const char* getName() const { return mName; }
+    const char* getDescription() const { return mDescription; }
+    virtual std::string getValueString() const = 0;
+
+    bool setFromString(std::string_view text);
+
+    /* Called on the thread that changed the value */
+    void setOnChanged(TDelegate<void()> onChanged) { mOnChanged = std::move(onChanged); }
+
+    /* Names are matched case insensitive */
+    static ConsoleVariable* find(std::string_view name);
+
+    /* "name value" or "name=value" sets the variable, a bare name logs its value and "cvars" lists all of them */
+    static bool execute(std::string_view command);
+
+    /* One command per line, lines starting with # are comments */
+    static bool executeConfigFile(const char* path);
+
+};
+
+/* Reads are a relaxed atomic load, cheap enough for hot paths and safe from worker threads */
+template<typename T>
+class TConsoleVariable final : public ConsoleVariable
+{
+    static_assert(std::is_same_v<T, bool> || std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, float>,
+        "Console variables are bool, int32_t, uint32_t or float");
+
+private:
+
+    std::atomic<T> mValue;
+
+protected:
+
+    bool parseValue(std::string_view text) override;
+
+public:
+
+    TConsoleVariable(const char* name, const T defaultValue, const char* description) : ConsoleVariable(name, description), mValue(defaultValue) {}
+
+    T get() const { return mValue.load(std::memory_order_relaxed); }
+
+    void set(const T value)
+    {
+        if (mValue.exchange(value, std::memory_order_relaxed) != value)
+        {
+            notifyChanged();
+        }
+    }
+
+    std::string getValueString() const override { return std::format("{}", get()); }
+
+};
+
+template<typename T>
+bool TConsoleVariable<T>::parseValue(const std::string_view text)
+{
+    T value;
+
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        if (text == "1" || text == "true" || text == "on") value = true;
+        else if (text == "0" || text == "false" || text == "off") value = false;
+        else return false;
+    }
+    else
+    {
+        const char* end = text.data() + text.size();
+        const auto [parsedEnd, error] = std::from_chars(text.data(), end, value);
+        if (error != std::errc() || parsedEnd != end) return false;
+    }
+
+    set(value);
+    return true;
+}
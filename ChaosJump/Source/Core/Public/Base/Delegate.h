@@ -0,0 +1,146 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature>
+class TDelegate;
+
+/*
+ * Move only replacement for std::function that never allocates, the callable lives in inline storage.
+ * Member functions bound with fromMethod only take the object pointer, lambdas may capture up to sInlineSize bytes.
+ */
+template<typename Return, typename... Args>
+class TDelegate<Return(Args...)>
+{
+
+public:
+
+    static constexpr size_t sInlineSize = 4 * sizeof(void*);
+
+private:
+
+    enum class Operation : uint8_t
+    {
+        Move,
+        Destroy
+    };
+
+    using InvokeFunction = Return (*)(void* storage, Args... args);
+    /* Null for trivially copyable callables, those are moved with memcpy and need no destruction */
+    using ManageFunction = void (*)(Operation operation, void* storage, void* sourceStorage);
+
+    alignas(std::max_align_t) mutable std::byte mStorage[sInlineSize];
+    InvokeFunction mInvoke = nullptr;
+    ManageFunction mManage = nullptr;
+
+    void moveFrom(TDelegate& other) noexcept
+    {
+        if (!other.mInvoke) return;
+
+        if (other.mManage)
+        {
+            other.mManage(Operation::Move, mStorage, other.mStorage);
+        }
+        else
+        {
+            memcpy(mStorage, other.mStorage, sInlineSize);
+        }
+
+        mInvoke = std::exchange(other.mInvoke, nullptr);
+        mManage = std::exchange(other.mManage, nullptr);
+    }
+
+public:
+
+    TDelegate() = default;
+
+    template<typename Callable>
+        requires (!std::is_same_v<std::decay_t<Callable>, TDelegate> && std::is_invocable_r_v<Return, std::decay_t<Callable>&, Args...>)
+    TDelegate(Callable&& callable)
+    {
+        using Stored = std::decay_t<Callable>;
+        static_assert(sizeof(Stored) <= sInlineSize, "Callable doesn't fit the inline storage, capture less or bind a member function");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t), "Callable is over aligned for the inline storage");
+        static_assert(std::is_nothrow_move_constructible_v<Stored>, "Callable has to be nothrow movable");
+
+        new (mStorage) Stored(std::forward<Callable>(callable));
+
+        mInvoke = [](void* storage, Args... args) -> Return
+        {
+            return (*static_cast<Stored*>(storage))(std::forward<Args>(args)...);
+        };
+
+        if constexpr (!std::is_trivially_copyable_v<Stored>)
+        {
+            mManage = [](const Operation operation, void* storage, void* sourceStorage)
+            {
+                if (operation == Operation::Move)
+                {
+                    Stored* source = static_cast<Stored*>(sourceStorage);
+                    new (storage) Stored(std::move(*source));
+                    source->~Stored();
+                }
+                else
+                {
+                    static_cast<Stored*>(storage)->~Stored();
+                }
+            };
+        }
+    }
+
+    /* Binds object->*Method, stores nothing but the object pointer */
+    template<auto Method, typename Object>
+    static TDelegate fromMethod(Object* object)
+    {
+        return TDelegate([object](Args... args) -> Return
+        {
+            return (object->*Method)(std::forward<Args>(args)...);
+        });
+    }
+
+    TDelegate(TDelegate&& other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    TDelegate& operator=(TDelegate&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    TDelegate(const TDelegate&) = delete;
+    TDelegate& operator=(const TDelegate&) = delete;
+
+    ~TDelegate()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        if (mManage)
+        {
+            mManage(Operation::Destroy, mStorage, nullptr);
+        }
+
+        mInvoke = nullptr;
+        mManage = nullptr;
+    }
+
+    explicit operator bool() const { return mInvoke; }
+
+    Return operator()(Args... args) const
+    {
+        return mInvoke(mStorage, std::forward<Args>(args)...);
+    }
+
+};
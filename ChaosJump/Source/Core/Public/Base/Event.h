@@ -1,41 +1,125 @@
 #pragma once
-#include <functional>
+#include <cstdint>
+#include <deque>
 #include <vector>
 
-#include <functional>
-#include <vector>
-#include <utility>
+#include "Base/Delegate.h"
+
+/* Identifies a subscription, the generation keeps a handle from unsubscribing whoever reuses its slot */
+struct EventHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != UINT32_MAX; }
+};
 
 template<typename Return, typename... Args>
 class TEvent
 {
-    using FuncType = std::function<Return(Args...)>;
-    using Entry = std::pair<size_t, FuncType>;
 
-    std::vector<Entry> mSubscribedFunctions;
-    size_t mNextId = 0;
+public:
+
+    using DelegateType = TDelegate<Return(Args...)>;
+
+private:
+
+    struct Slot
+    {
+        DelegateType delegate;
+        uint32_t generation = 0;
+        bool bBound = false;
+    };
+
+    /* A deque so slots stay in place while a delegate subscribes from within a broadcast */
+    std::deque<Slot> mSlots;
+    std::vector<uint32_t> mFreeSlots;
+
+    /* Unsubscribed during a broadcast, released once it returns so a delegate can unsubscribe itself */
+    std::vector<uint32_t> mPendingFreeSlots;
+    uint32_t mBroadcastDepth = 0;
+
+    void releaseSlot(const uint32_t index)
+    {
+        mSlots[index].delegate.reset();
+        mFreeSlots.push_back(index);
+    }
 
 public:
-    
-    size_t subscribe(FuncType function)
+
+    TEvent() = default;
+
+    TEvent(const TEvent&) = delete;
+    TEvent& operator=(const TEvent&) = delete;
+
+    EventHandle subscribe(DelegateType delegate)
     {
-        size_t id = mNextId++;
-        mSubscribedFunctions.emplace_back(id, std::move(function));
-        return id;
+        uint32_t index;
+
+        // A reused slot could sit after the delegate running right now, appending keeps it out of the ongoing broadcast.
+        if (!mFreeSlots.empty() && !mBroadcastDepth)
+        {
+            index = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(mSlots.size());
+            mSlots.emplace_back();
+        }
+
+        Slot& slot = mSlots[index];
+        slot.delegate = std::move(delegate);
+        slot.bBound = true;
+
+        return {.index = index, .generation = slot.generation};
     }
 
-    void unsubscribe(size_t id)
+    /* Stale handles are ignored */
+    void unsubscribe(const EventHandle handle)
     {
-        auto it = std::remove_if(mSubscribedFunctions.begin(), mSubscribedFunctions.end(),
-            [id](const Entry& e) { return e.first == id; });
-        mSubscribedFunctions.erase(it, mSubscribedFunctions.end());
+        if (handle.index >= mSlots.size()) return;
+
+        Slot& slot = mSlots[handle.index];
+        if (!slot.bBound || slot.generation != handle.generation) return;
+
+        slot.bBound = false;
+        ++slot.generation;
+
+        if (mBroadcastDepth)
+        {
+            mPendingFreeSlots.push_back(handle.index);
+        }
+        else
+        {
+            releaseSlot(handle.index);
+        }
     }
 
+    /* Delegates subscribed during the broadcast are first called by the next one */
     void broadcast(Args... args)
     {
-        for (auto& [id, func] : mSubscribedFunctions)
+        ++mBroadcastDepth;
+
+        const size_t slotCount = mSlots.size();
+        for (size_t i = 0; i < slotCount; ++i)
         {
-            func(args...);
+            const Slot& slot = mSlots[i];
+            if (slot.bBound)
+            {
+                slot.delegate(args...);
+            }
+        }
+
+        if (--mBroadcastDepth == 0)
+        {
+            for (const uint32_t index : mPendingFreeSlots)
+            {
+                releaseSlot(index);
+            }
+
+            mPendingFreeSlots.clear();
         }
     }
+
 };
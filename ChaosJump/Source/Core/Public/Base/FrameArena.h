@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/*
+ * Bump allocator for data that dies within the frame, every thread allocates from its own arena.
+ * All arenas are reset by Application at the end of a run loop iteration, nothing allocated here may outlive it.
+ */
+class FrameArena
+{
+
+private:
+
+    static constexpr size_t sBlockSize = 64 * 1024;
+
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size = 0;
+    };
+
+    std::vector<Block> mBlocks;
+    size_t mBlockIndex = 0;
+    size_t mBlockOffset = 0;
+
+    size_t mAllocatedBytes = 0;
+
+    static std::atomic<size_t> sLastFrameBytes;
+
+    void registerArena();
+    void unregisterArena();
+
+    void reset();
+
+public:
+
+    FrameArena();
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment);
+
+    /* Arena of the calling thread */
+    static FrameArena& get();
+
+    /* Only call while no other thread allocates, i.e. between frames */
+    static void resetAll();
+
+    /* Summed over all threads */
+    static size_t getLastFrameBytes() { return sLastFrameBytes.load(std::memory_order_relaxed); }
+
+};
+
+/* Deallocation is a no-op, the memory comes back with the next reset */
+template<typename T>
+class TFrameAllocator
+{
+
+public:
+
+    using value_type = T;
+
+    TFrameAllocator() = default;
+
+    template<typename U>
+    TFrameAllocator(const TFrameAllocator<U>&) {}
+
+    T* allocate(const size_t count)
+    {
+        return static_cast<T*>(FrameArena::get().allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) {}
+
+    template<typename U>
+    bool operator==(const TFrameAllocator<U>&) const { return true; }
+
+};
+
+template<typename T>
+using TFrameVector = std::vector<T, TFrameAllocator<T>>;
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/* Read only view of a whole file, pages are loaded by the OS on first access instead of being copied up front */
+class MappedFile
+{
+
+private:
+
+    const std::byte* mData = nullptr;
+    size_t mSize = 0;
+
+#ifdef _WIN32
+    void* mFileHandle = nullptr;
+    void* mMappingHandle = nullptr;
+#else
+    int mFileDescriptor = -1;
+#endif
+
+public:
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /* Closes the current file first, empty files fail to map */
+    bool open(const char* path);
+    void close();
+
+    bool isOpen() const { return mData; }
+    const std::byte* getData() const { return mData; }
+    size_t getSize() const { return mSize; }
+
+};
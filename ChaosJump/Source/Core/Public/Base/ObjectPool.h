@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "Debugging/DebugDefinitions.h"
+
+struct ObjectPoolStats
+{
+    size_t slotSize = 0;
+    uint32_t capacity = 0;
+    uint32_t liveCount = 0;
+    uint32_t peakLiveCount = 0;
+    uint32_t blockCount = 0;
+};
+
+class ObjectPool;
+
+/* Destroys the object and hands its slot back, works through base class pointers of polymorphic types */
+struct PoolDeleter
+{
+    ObjectPool* pool = nullptr;
+
+    template<typename T>
+    void operator()(T* object) const;
+};
+
+template<typename T>
+using TPooledPtr = std::unique_ptr<T, PoolDeleter>;
+
+/*
+ * Fixed size slots carved out of blocks that are only freed with the pool, released slots go on an intrusive free list.
+ * One pool can serve several types as long as they fit the slot, e.g. all obstacle shapes.
+ */
+class ObjectPool
+{
+
+private:
+
+    struct FreeSlot
+    {
+        FreeSlot* next;
+    };
+
+    struct BlockDeleter
+    {
+        void operator()(std::byte* block) const;
+    };
+
+    size_t mSlotSize = 0;
+    uint32_t mSlotsPerBlock = 0;
+
+    std::vector<std::unique_ptr<std::byte[], BlockDeleter>> mBlocks;
+    FreeSlot* mFreeList = nullptr;
+
+    uint32_t mLiveCount = 0;
+    uint32_t mPeakLiveCount = 0;
+
+    void addBlock();
+
+public:
+
+    ObjectPool(size_t slotSize, uint32_t slotsPerBlock);
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    void* allocate();
+    void release(void* slot);
+
+    /* T has to fit the slot, otherwise the pool was set up without it in getSlotSizeFor and this fails hard */
+    template<typename T, typename... Args>
+    TPooledPtr<T> create(Args&&... args);
+
+    ObjectPoolStats getStats() const;
+
+    template<typename... Types>
+    static constexpr size_t getSlotSizeFor() { return std::max({sizeof(Types)..., sizeof(FreeSlot)}); }
+
+};
+
+template<typename T, typename... Args>
+TPooledPtr<T> ObjectPool::create(Args&&... args)
+{
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Slots are only aligned to the default new alignment");
+
+    // Callers use the object right away, so a type that doesn't fit must not turn into a null to dereference later.
+    assert(sizeof(T) <= mSlotSize && "Type is bigger than the pool's slots");
+    if (!ensure(sizeof(T) <= mSlotSize))
+    {
+        std::abort();
+    }
+
+    void* slot = allocate();
+    return TPooledPtr<T>(new (slot) T(std::forward<Args>(args)...), PoolDeleter{.pool = this});
+}
+
+template<typename T>
+void PoolDeleter::operator()(T* object) const
+{
+    // With multiple inheritance the base pointer isn't necessarily where the slot starts.
+    void* slot;
+    if constexpr (std::is_polymorphic_v<T>)
+    {
+        slot = dynamic_cast<void*>(object);
+    }
+    else
+    {
+        slot = object;
+    }
+
+    object->~T();
+    pool->release(slot);
+}
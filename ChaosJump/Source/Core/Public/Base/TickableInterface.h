@@ -1,24 +1,103 @@
 ﻿#pragma once
-#include <stack>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
+/* Phases tick in declaration order, tickables of a phase in registration order */
+enum class TickPhase : uint8_t
+{
+    PrePhysics,
+    /*
+     * Ticked across the job system, e.g. the KeyTriggerTickable of every InputReceiverInterface. Only for tickables that read
+     * shared state and write their own, they must not destroy or touch other tickables. Only plain tickables may be created here:
+     * drawables, collision objects and anything from an ObjectPool register in unguarded lists and have to be created on the
+     * simulation thread outside of this phase.
+     */
+    Parallel,
+    Physics,
+    PostPhysics,
+    /* Camera and anything else that has to see the final locations of the frame */
+    Late,
+    Count
+};
+
+const char* getTickPhaseName(TickPhase phase);
+
+enum class TickPriority : uint8_t
+{
+    Normal,
+    /* Ticks while the frame's low priority budget lasts, otherwise keeps accumulating delta until sMaxLowPriorityTickDelay */
+    Low
+};
+
 class TickableInterface
 {
 
 private:
 
-    uint8_t mTickOrder = UINT8_MAX;
+    TickPhase mTickPhase = TickPhase::Physics;
+
+    /* Slot in the tick group, destroying only nulls it so removal is O(1) and the order stays stable */
+    uint32_t mTickIndex = UINT32_MAX;
+
+    TickPriority mTickPriority = TickPriority::Normal;
+
+    /* Both have to be reached before the next tick, which gets the delta accumulated since the last one */
+    float mTickInterval = 0.f;
+    uint32_t mTickFrameInterval = 1;
+
+    float mAccumulatedDeltaTime = 0.f;
+    uint32_t mAccumulatedFrames = 0;
+
+    static float sLowPriorityTickBudget;
+    static float sMaxLowPriorityTickDelay;
 
     static bool bTickInProgress;
-    static std::stack<TickableInterface*> sTickablesCreatedInTick;
-    static std::vector<TickableInterface*> sTickables;
+
+    /* Added to their tick group once the tick is done, guarded since the parallel phase can create plain tickables */
+    static std::mutex sTickablesCreatedInTickMutex;
+    static std::vector<TickableInterface*> sTickablesCreatedInTick;
+
+    static std::vector<TickableInterface*> sTickGroups[static_cast<size_t>(TickPhase::Count)];
+    static std::atomic<bool> sTickGroupHasHoles[static_cast<size_t>(TickPhase::Count)];
     friend class Application;
 
+    static void addToTickGroup(TickableInterface* tickable);
+
+    /* Drops the nulled slots in a single pass */
+    static void compactTickGroup(TickPhase phase);
+    static void addTickablesCreatedInTick();
+
+    /* Returns true when the tick is due */
+    bool accumulateTickDelta(float deltaTime);
+    void tickAccumulated();
+
 public:
 
-    TickableInterface();
+    TickableInterface(TickPhase tickPhase = TickPhase::Physics);
     virtual ~TickableInterface();
 
+    // The tick group slot belongs to this instance, a copy would free it when destroyed.
+    TickableInterface(const TickableInterface&) = delete;
+    TickableInterface& operator=(const TickableInterface&) = delete;
+
+    TickPhase getTickPhase() const { return mTickPhase; }
+
+    TickPriority getTickPriority() const { return mTickPriority; }
+    void setTickPriority(TickPriority tickPriority);
+
+    /** \param seconds 0 ticks every frame */
+    void setTickInterval(float seconds);
+
+    /** \param frames 1 ticks every frame */
+    void setTickFrameInterval(uint32_t frames);
+
+    /* Frame time all low priority tickables may share per frame */
+    static void setLowPriorityTickBudget(float seconds);
+    static float getLowPriorityTickBudget() { return sLowPriorityTickBudget; }
+    static float getMaxLowPriorityTickDelay() { return sMaxLowPriorityTickDelay; }
+
     virtual void tick(float deltaTime) = 0;
     
 };
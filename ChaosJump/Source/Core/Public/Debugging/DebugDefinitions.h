@@ -1,10 +1,18 @@
 #pragma once
 
+// Compiles DEBUG_DRAW_LINE in, debug.DrawLines toggles drawing at runtime
 #define DRAW_DEBUG_LINES 0
 #define DRAW_FPS 1
 #define DEBUG_SAT_POLYGON_COLLISION 0
 #define DEBUG_SAT_CIRCLE_COLLISION 0
 #define DEBUG_SAT_RECTANGLE_COLLISION 0
+#define ENABLE_PROFILER 0
+// Replaces the global operator new and delete to count allocations per MemoryTag
+#define ENABLE_MEMORY_TRACKING 0
+// Keeps the last frames of physics state once debug.RecordPhysics is on, F6 dumps them and F7 opens the viewer
+#define ENABLE_PHYSICS_RECORDER 0
+// Log calls below this severity are compiled out, 0 Verbose, 1 Info, 2 Warning, 3 Error
+#define LOG_MIN_SEVERITY 1
 
 
 inline bool ensureCondition(bool condition)
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Debugging/DebugDefinitions.h"
+#include "Render/RenderPacket.h"
+
+#if DRAW_DEBUG_LINES
+
+/* DEBUG_DRAW_LINE({.start = a, .end = b, .color = {.r = 1}, .duration = 2.f}), the arguments aren't even evaluated when disabled */
+#define DEBUG_DRAW_LINE(...) DebugDraw::addLine(__VA_ARGS__)
+
+#else
+
+#define DEBUG_DRAW_LINE(...)
+
+#endif
+
+/*
+ * Lines live in a fixed ring, once it is full the oldest line is overwritten so debug drawing can never grow memory.
+ * Lines may be added from any thread, the render packet extraction ages them and drops the expired ones.
+ */
+class DebugDraw
+{
+
+public:
+
+    static constexpr uint32_t sCapacity = 8192;
+
+    static void addLine(const DebugLine& line);
+
+    /* Appends every live line to outLines and ages them by deltaSeconds, nothing is appended while debug.DrawLines is off */
+    static void extractLines(std::vector<DebugLine>& outLines, float deltaSeconds);
+
+    /* All lines go out in a single geometry call, each one as a one pixel wide quad. Compiled in either way for other debug views. */
+    static void drawLines(SDL_Renderer* renderer, const std::vector<DebugLine>& lines, const Vector2& viewLocation);
+
+};
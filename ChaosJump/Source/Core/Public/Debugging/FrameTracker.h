@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum class FramePhase : uint8_t
+{
+    NetReceive,
+    Input,
+    Tick,
+    Callbacks,
+    Draw,
+    Count
+};
+
+enum class FrameTimeWindow : uint8_t
+{
+    OneSecond,
+    TenSeconds,
+    SixtySeconds,
+    Count
+};
+
+const char* getFramePhaseName(FramePhase phase);
+const char* getFrameTimeWindowName(FrameTimeWindow window);
+
+/* All times in seconds */
+struct FrameTimeStats
+{
+    uint32_t sampleCount = 0;
+    float average = 0.f;
+    float p50 = 0.f;
+    float p95 = 0.f;
+    float p99 = 0.f;
+
+    /* Average frame time of the slowest 1% of frames */
+    float onePercentLow = 0.f;
+
+    float phaseAverages[static_cast<size_t>(FramePhase::Count)] = {};
+};
+
+/*
+ * Keeps the last sCapacity frames in a ring buffer and a log scale histogram for every rolling window,
+ * so pushing a frame and querying percentiles are constant time regardless of session length.
+ */
+class FrameTracker
+{
+
+public:
+
+    static constexpr uint32_t sCapacity = 1 << 14;
+    static constexpr uint32_t sHistogramBucketCount = 128;
+
+    struct FrameSample
+    {
+        float frameTime = 0.f;
+        float phaseTimes[static_cast<size_t>(FramePhase::Count)] = {};
+    };
+
+private:
+
+    struct RollingWindow
+    {
+        float duration = 0.f;
+        uint32_t tail = 0;
+        uint32_t sampleCount = 0;
+        double totalTime = 0.0;
+        double phaseTotals[static_cast<size_t>(FramePhase::Count)] = {};
+        uint32_t bucketCounts[sHistogramBucketCount] = {};
+        double bucketTimes[sHistogramBucketCount] = {};
+    };
+
+    float mTotalFrameTime = 0.f;
+    uint64_t mFrameCounter = 0;
+
+    float lastFrameTime = 0.f;
+
+    std::unique_ptr<FrameSample[]> mSamples = std::make_unique<FrameSample[]>(sCapacity);
+    uint32_t mHead = 0;
+    uint32_t mSampleCount = 0;
+
+    /* Phases of the frame in flight, committed with the next pushFrameTime */
+    float mCurrentPhaseTimes[static_cast<size_t>(FramePhase::Count)] = {};
+
+    RollingWindow mWindows[static_cast<size_t>(FrameTimeWindow::Count)];
+
+    static uint32_t getBucketIndex(float frameTime);
+    void addToWindow(RollingWindow& window, const FrameSample& sample) const;
+    void evictFromWindow(RollingWindow& window) const;
+
+    /* Average frame time of the slowest fraction of the window, approximated from the histogram */
+    static double getSlowestAverageFrameTime(const RollingWindow& window, float fraction);
+
+public:
+
+    FrameTracker();
+
+    uint64_t getFrameCounter() const { return mFrameCounter; }
+
+    void pushFrameTime(float frameTime);
+
+    /* Can be called from the thread running the phase, every phase only has a single writer */
+    void addPhaseTime(FramePhase phase, float phaseTime);
+
+    float getCurrentFPS() const;
+    float getAverageFPS() const;
+
+    /**
+     * Average FPS of the slowest frames in the last sixty seconds.
+     * \param fraction expects value 0-1
+     */
+    float getLowestPercentageFPS(float fraction) const;
+
+    FrameTimeStats getStats(FrameTimeWindow window) const;
+
+    /* Exact stats over every buffered frame, sorts a copy so it's meant for reports rather than per frame queries */
+    FrameTimeStats getBufferedStats() const;
+
+    /* Oldest to newest, at most count frames */
+    void getRecentFrameTimes(uint32_t count, std::vector<float>& outFrameTimes) const;
+
+    /* .json writes the window stats, anything else every buffered frame as CSV */
+    bool writeToFile(const char* path) const;
+
+};
@@ -0,0 +1,220 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "Debugging/DebugDefinitions.h"
+
+enum class LogSeverity : uint8_t
+{
+    Verbose,
+    Info,
+    Warning,
+    Error
+};
+
+const char* getLogSeverityName(LogSeverity severity);
+
+/* Copied into the record as is and printed as hex by the logging thread */
+struct LogHexBytes
+{
+    std::string_view bytes;
+};
+
+template<>
+struct std::formatter<LogHexBytes> : std::formatter<std::string_view>
+{
+    auto format(const LogHexBytes& hexBytes, std::format_context& context) const
+    {
+        auto out = context.out();
+        for (size_t i = 0; i < hexBytes.bytes.size(); ++i)
+        {
+            out = std::format_to(out, "{}{:02x}", i ? " " : "", static_cast<uint8_t>(hexBytes.bytes[i]));
+        }
+        return out;
+    }
+};
+
+/*
+ * Callers only copy the format string pointer and the raw arguments into a slot of a lock free ring buffer,
+ * formatting and writing happens on the logging thread. A full buffer drops records instead of blocking the caller.
+ * Strings are copied up to what fits the slot, any other argument has to be trivially copyable.
+ */
+class Logger
+{
+
+private:
+
+    static constexpr uint32_t sSlotCount = 4096;
+    static constexpr size_t sSlotSize = 256;
+
+    using FormatFunction = void (*)(std::string_view format, const std::byte* payload, std::string& outText);
+
+    struct LogRecordHeader
+    {
+        /* Even while the slot is free for the writer of that lap, odd once the record is ready to be read */
+        std::atomic<uint64_t> turn = 0;
+
+        LogSeverity severity = LogSeverity::Info;
+        uint16_t payloadSize = 0;
+        uint32_t formatSize = 0;
+        const char* format = nullptr;
+        FormatFunction formatFunction = nullptr;
+        uint64_t timestampNanoseconds = 0;
+    };
+
+    static constexpr size_t sPayloadCapacity = sSlotSize - sizeof(LogRecordHeader);
+
+    struct alignas(64) LogRecord : LogRecordHeader
+    {
+        std::byte payload[sPayloadCapacity];
+    };
+
+    static LogRecord sRecords[sSlotCount];
+    static std::atomic<uint64_t> sWriteIndex;
+    static std::atomic<uint64_t> sDroppedCount;
+    static std::atomic<LogSeverity> sMinSeverity;
+
+    static LogRecord* acquireRecord(LogSeverity severity, std::string_view format);
+    static void publishRecord(LogRecord* record);
+
+    /* Logging thread only, formats and writes every published record in order and returns whether there was any */
+    static bool drainRecords(std::string& text, std::string& line);
+
+    template<typename T>
+    static constexpr bool isStringArgument = std::is_convertible_v<const T&, std::string_view>;
+
+    template<typename T>
+    using TStoredArgument = std::conditional_t<isStringArgument<std::decay_t<T>>, std::string_view, std::conditional_t<std::is_same_v<std::decay_t<T>, LogHexBytes>, LogHexBytes, std::decay_t<T>>>;
+
+    template<typename T>
+    static constexpr size_t getFixedArgumentSize() { return isStringArgument<T> || std::is_same_v<T, LogHexBytes> ? sizeof(uint16_t) : sizeof(T); }
+
+    /* Strings share whatever the fixed size arguments leave of the payload */
+    template<typename T>
+    static void encodeArgument(const T& argument, std::byte* payload, size_t& offset, size_t& stringBudget);
+
+    template<typename T>
+    static T decodeArgument(const std::byte* payload, size_t& offset);
+
+    template<typename... Stored>
+    static void formatRecord(std::string_view format, const std::byte* payload, std::string& outText);
+
+public:
+
+    /* Starts the logging thread, records written before are kept and printed once it runs */
+    static void start(const char* filePath = nullptr);
+
+    /* Writes everything still buffered and joins the logging thread */
+    static void stop();
+
+    static void setMinSeverity(LogSeverity severity) { sMinSeverity.store(severity, std::memory_order_relaxed); }
+    static bool isEnabled(const LogSeverity severity) { return severity >= sMinSeverity.load(std::memory_order_relaxed); }
+
+    template<typename... Args>
+    static void write(LogSeverity severity, std::format_string<Args...> format, Args&&... args);
+
+};
+
+template<typename T>
+void Logger::encodeArgument(const T& argument, std::byte* payload, size_t& offset, size_t& stringBudget)
+{
+    if constexpr (std::is_same_v<T, LogHexBytes> || isStringArgument<T>)
+    {
+        const std::string_view text = [&argument]()
+        {
+            if constexpr (std::is_same_v<T, LogHexBytes>) return argument.bytes;
+            else return std::string_view(argument);
+        }();
+
+        const uint16_t size = static_cast<uint16_t>(std::min(text.size(), stringBudget));
+        stringBudget -= size;
+
+        memcpy(payload + offset, &size, sizeof(size));
+        memcpy(payload + offset + sizeof(size), text.data(), size);
+        offset += sizeof(size) + size;
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Log arguments have to be strings or trivially copyable");
+        memcpy(payload + offset, &argument, sizeof(T));
+        offset += sizeof(T);
+    }
+}
+
+template<typename T>
+T Logger::decodeArgument(const std::byte* payload, size_t& offset)
+{
+    if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, LogHexBytes>)
+    {
+        uint16_t size;
+        memcpy(&size, payload + offset, sizeof(size));
+
+        const std::string_view text(reinterpret_cast<const char*>(payload + offset + sizeof(size)), size);
+        offset += sizeof(size) + size;
+
+        return T{text};
+    }
+    else
+    {
+        T argument;
+        memcpy(&argument, payload + offset, sizeof(T));
+        offset += sizeof(T);
+        return argument;
+    }
+}
+
+template<typename... Stored>
+void Logger::formatRecord(const std::string_view format, [[maybe_unused]] const std::byte* payload, std::string& outText)
+{
+    // Both stay unused for formats without arguments.
+    [[maybe_unused]] size_t offset = 0;
+
+    // Braced initialization decodes left to right.
+    const std::tuple<Stored...> arguments{decodeArgument<Stored>(payload, offset)...};
+
+    std::apply([&](const Stored&... storedArguments)
+    {
+        outText = std::vformat(format, std::make_format_args(storedArguments...));
+    }, arguments);
+}
+
+template<typename... Args>
+void Logger::write(const LogSeverity severity, std::format_string<Args...> format, Args&&... args)
+{
+    constexpr size_t fixedSize = (getFixedArgumentSize<TStoredArgument<Args>>() + ... + 0);
+    static_assert(fixedSize <= sPayloadCapacity, "Log arguments don't fit a record");
+
+    LogRecord* record = acquireRecord(severity, format.get());
+    if (!record) return;
+
+    size_t offset = 0;
+    [[maybe_unused]] size_t stringBudget = sPayloadCapacity - fixedSize;
+    (encodeArgument<TStoredArgument<Args>>(args, record->payload, offset, stringBudget), ...);
+
+    record->payloadSize = static_cast<uint16_t>(offset);
+    record->formatFunction = &formatRecord<TStoredArgument<Args>...>;
+
+    publishRecord(record);
+}
+
+/* LOG(Warning, "Couldn't open {}", path), the format is checked at compile time. Levels below LOG_MIN_SEVERITY compile to nothing. */
+#define LOG(Severity, ...) \
+    do \
+    { \
+        if constexpr (static_cast<int>(LogSeverity::Severity) >= LOG_MIN_SEVERITY) \
+        { \
+            if (Logger::isEnabled(LogSeverity::Severity)) \
+            { \
+                Logger::write(LogSeverity::Severity, __VA_ARGS__); \
+            } \
+        } \
+    } \
+    while (false)
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Debugging/DebugDefinitions.h"
+
+#if ENABLE_MEMORY_TRACKING
+
+#define MEMORY_CONCAT_INNER(a, b) a##b
+#define MEMORY_CONCAT(a, b) MEMORY_CONCAT_INNER(a, b)
+
+/* Heap allocations of this thread are charged to tag until the scope ends */
+#define MEMORY_SCOPE(tag) const MemoryTagScope MEMORY_CONCAT(memoryScope, __LINE__)(tag)
+
+#else
+
+#define MEMORY_SCOPE(tag)
+
+#endif
+
+enum class MemoryTag : uint8_t
+{
+    Core,
+    Physics,
+    Networking,
+    Rendering,
+    Gameplay,
+    Count
+};
+
+const char* getMemoryTagName(MemoryTag tag);
+
+struct MemoryTagStats
+{
+    uint64_t allocationCount = 0;
+    uint64_t allocatedBytes = 0;
+    int64_t liveBytes = 0;
+    int64_t peakLiveBytes = 0;
+
+    /* Of the last frame that ended, see MemoryTracker::endFrame */
+    uint64_t frameAllocationCount = 0;
+    uint64_t frameAllocatedBytes = 0;
+    uint64_t peakFrameAllocationCount = 0;
+};
+
+/*
+ * Counts heap allocations per tag when ENABLE_MEMORY_TRACKING replaces the global operator new and delete.
+ * Every allocation carries a small header with its size and tag, so a free is charged to the tag that allocated it
+ * no matter which thread or scope releases it. Aligned and placement new are not tracked.
+ */
+class MemoryTracker
+{
+
+public:
+
+    static MemoryTag getThreadTag();
+
+    /* Returns the previous tag */
+    static MemoryTag setThreadTag(MemoryTag tag);
+
+    static void recordAllocation(MemoryTag tag, size_t size);
+    static void recordFree(MemoryTag tag, size_t size);
+
+    /* Latches the per frame counters, called once at the end of every frame */
+    static void endFrame();
+
+    static MemoryTagStats getStats(MemoryTag tag);
+
+    /* One line per tag, also what the overlay shows */
+    static bool writeReport(const char* path);
+
+};
+
+class MemoryTagScope
+{
+
+private:
+
+    MemoryTag mPreviousTag;
+
+public:
+
+    explicit MemoryTagScope(const MemoryTag tag) : mPreviousTag(MemoryTracker::setThreadTag(tag)) {}
+
+    ~MemoryTagScope()
+    {
+        MemoryTracker::setThreadTag(mPreviousTag);
+    }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+};
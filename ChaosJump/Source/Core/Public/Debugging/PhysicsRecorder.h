@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Debugging/DebugDefinitions.h"
+#include "Math/Vector2.h"
+
+class CollisionObject;
+struct RenderPacket;
+enum class CollisionCategory : uint32_t;
+
+/* State of one body after the physics phase, the collision fields describe its move of that frame */
+struct PhysicsBodyRecord
+{
+    /* Only identifies the body within the recording, never dereferenced */
+    const CollisionObject* body = nullptr;
+    const CollisionObject* otherBody = nullptr;
+
+    Vector2 location = {};
+    Vector2 velocity = {};
+    Vector2 collisionNormal = {};
+
+    CollisionCategory category = {};
+
+    bool bMoved = false;
+    bool bCollided = false;
+    bool bBlocked = false;
+};
+
+struct PhysicsFrameRecord
+{
+    uint64_t frameNumber = 0;
+    float deltaSeconds = 0.f;
+
+    /* Keeps its capacity when the slot gets reused, recording doesn't allocate once the ring went around */
+    std::vector<PhysicsBodyRecord> bodies = {};
+};
+
+/*
+ * Keeps the physics state of the last sFrameCapacity frames in a ring, without touching the live frame like the DEBUG_SAT_* lines do.
+ * The ring can be written out as CSV or inspected in the viewer, which stops recording and draws the selected frame over the game.
+ * Recording happens in the tick, everything else must be called between ticks.
+ */
+class PhysicsRecorder
+{
+
+public:
+
+    static constexpr uint32_t sFrameCapacity = 600;
+
+    /* Called once the physics phase is done, skipped while debug.RecordPhysics is off or the viewer is open */
+    static void recordFrame(uint64_t frameNumber, float deltaSeconds);
+
+    /* One line per recorded body, oldest frame first */
+    static bool writeToFile(const char* path);
+
+    static bool isViewing();
+    static void setViewing(bool bViewing);
+
+    /* Moves the viewed frame by frameOffset, positive towards newer frames */
+    static void scrub(int32_t frameOffset);
+
+    /* Appends the viewed frame as debug lines and its summary as display text */
+    static void extractViewerFrame(RenderPacket& packet);
+
+    static uint32_t getFrameCount();
+
+};
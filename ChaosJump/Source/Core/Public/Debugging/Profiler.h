@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Debugging/DebugDefinitions.h"
+
+#if ENABLE_PROFILER
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/* name has to outlive the capture, string literals only */
+#define PROFILE_SCOPE(name) const ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_THREAD_NAME(name)
+
+#endif
+
+struct ProfileZone
+{
+    const char* name = nullptr;
+    uint64_t startNanoseconds = 0;
+    uint64_t endNanoseconds = 0;
+    uint32_t depth = 0;
+};
+
+/*
+ * Every thread records into its own fixed size buffer, only the owning thread writes and the exporter reads up to the
+ * published count, so recording a zone never locks. Zones past the capacity of a capture are dropped and counted.
+ */
+class Profiler
+{
+
+public:
+
+    static constexpr uint32_t sZonesPerThread = 1 << 16;
+
+private:
+
+    struct ThreadBuffer
+    {
+        std::unique_ptr<ProfileZone[]> zones = std::make_unique<ProfileZone[]>(sZonesPerThread);
+        std::atomic<uint32_t> zoneCount = 0;
+        std::atomic<uint32_t> captureId = 0;
+        std::atomic<const char*> threadName = nullptr;
+        std::atomic<uint32_t> droppedZoneCount = 0;
+        uint32_t depth = 0;
+        uint32_t threadIndex = 0;
+    };
+
+    static std::atomic<bool> bCapturing;
+    static std::atomic<uint32_t> sCaptureId;
+    static std::atomic<uint64_t> sCaptureStartNanoseconds;
+
+    /* Buffers are never freed so zones of finished threads can still be exported */
+    static std::mutex sThreadBuffersMutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> sThreadBuffers;
+
+    static ThreadBuffer& getThreadBuffer();
+
+public:
+
+    static uint64_t getTimestamp();
+
+    static bool isCapturing() { return bCapturing.load(std::memory_order_relaxed); }
+
+    /* Discards zones of the previous capture */
+    static void startCapture();
+    static void stopCapture();
+
+    /* Writes the last capture as Chrome trace event JSON, open with chrome://tracing or ui.perfetto.dev */
+    static bool writeTrace(const char* path);
+
+    static void setThreadName(const char* name);
+
+    /* Returns the depth of the opened zone, used by ProfileScope */
+    static uint32_t beginZone();
+    static void endZone(const char* name, uint64_t startNanoseconds, uint32_t depth);
+
+};
+
+class ProfileScope
+{
+
+private:
+
+    const char* mName;
+    uint64_t mStartNanoseconds = 0;
+    uint32_t mDepth = 0;
+    bool bRecording = false;
+
+public:
+
+    explicit ProfileScope(const char* name) : mName(name)
+    {
+        if (!Profiler::isCapturing()) return;
+
+        bRecording = true;
+        mDepth = Profiler::beginZone();
+        mStartNanoseconds = Profiler::getTimestamp();
+    }
+
+    ~ProfileScope()
+    {
+        if (!bRecording) return;
+
+        Profiler::endZone(mName, mStartNanoseconds, mDepth);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Math/Vector2.h"
+#include "Render/DrawableInterface.h"
+
+class CollisionShapeInterface;
+struct RenderMesh;
+
+enum class ComponentType : uint8_t
+{
+    Transform,
+    Body,
+    Shape,
+    RenderMesh,
+    Color,
+    Network,
+    Count
+};
+
+using ComponentMask = uint32_t;
+
+struct TransformComponent
+{
+    static constexpr ComponentType sType = ComponentType::Transform;
+
+    Vector2 location = {};
+};
+
+/* Integrated by integrateEntityBodies, same damping and gravity model as CollisionObject */
+struct BodyComponent
+{
+    static constexpr ComponentType sType = ComponentType::Body;
+
+    Vector2 velocity = {};
+    Vector2 gravity = {.x = 0, .y = 981.f};
+    Vector2 dampingPerSecond = {};
+};
+
+struct ShapeComponent
+{
+    static constexpr ComponentType sType = ComponentType::Shape;
+
+    /* Half size of the bounding box around the location, used for culling */
+    Vector2 boundsExtent = {};
+
+    /* Not owned, set by objects migrating over that still own their shape */
+    const CollisionShapeInterface* collisionShape = nullptr;
+};
+
+struct RenderMeshComponent
+{
+    static constexpr ComponentType sType = ComponentType::RenderMesh;
+
+    std::shared_ptr<const RenderMesh> mesh = nullptr;
+};
+
+struct ColorComponent
+{
+    static constexpr ComponentType sType = ComponentType::Color;
+
+    Color color = {.r = 1, .g = 1, .b = 1};
+};
+
+struct NetworkComponent
+{
+    static constexpr ComponentType sType = ComponentType::Network;
+
+    uint32_t netGUID = 0;
+
+    /* HSteamNetConnection, 0 is locally owned */
+    uint32_t owningConnection = 0;
+};
+
+template<typename... Components>
+struct TComponentList
+{
+    using Columns = std::tuple<std::vector<Components>...>;
+
+    template<typename Function>
+    static void forEach(Function&& function)
+    {
+        (function(std::type_identity<Components>{}), ...);
+    }
+};
+
+/* Every component an archetype can store, a new component type has to be added here and to ComponentType */
+using EntityComponentList = TComponentList<TransformComponent, BodyComponent, ShapeComponent, RenderMeshComponent, ColorComponent, NetworkComponent>;
+
+template<typename Component>
+constexpr ComponentMask getComponentBit()
+{
+    return ComponentMask{1} << static_cast<uint8_t>(Component::sType);
+}
+
+template<typename... Components>
+constexpr ComponentMask makeComponentMask()
+{
+    return (getComponentBit<Components>() | ... | ComponentMask{0});
+}
@@ -0,0 +1,186 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Entities/EntityComponents.h"
+
+struct EntityHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != UINT32_MAX; }
+    bool operator==(const EntityHandle& other) const = default;
+};
+
+/* All entities with the same component set, every component type is one dense column indexed by row */
+class EntityArchetype
+{
+
+private:
+
+    ComponentMask mMask = 0;
+    std::vector<uint32_t> mEntityIndices;
+    EntityComponentList::Columns mColumns;
+
+    friend class EntityStore;
+
+    uint32_t addRow(uint32_t entityIndex);
+
+    /* Swaps the last row into row, returns the entity index that moved or UINT32_MAX */
+    uint32_t removeRow(uint32_t row);
+
+    /* Moves the components both archetypes have, the others keep their defaults */
+    void moveRowTo(uint32_t row, EntityArchetype& otherArchetype, uint32_t otherRow);
+
+public:
+
+    explicit EntityArchetype(ComponentMask mask) : mMask(mask) {}
+
+    ComponentMask getMask() const { return mMask; }
+    bool hasComponents(ComponentMask mask) const { return (mMask & mask) == mask; }
+    uint32_t getSize() const { return static_cast<uint32_t>(mEntityIndices.size()); }
+
+    template<typename Component>
+    std::vector<Component>& getColumn() { return std::get<std::vector<Component>>(mColumns); }
+
+    template<typename Component>
+    const std::vector<Component>& getColumn() const { return std::get<std::vector<Component>>(mColumns); }
+
+};
+
+/*
+ * Archetype based entity storage so objects can move off the inheritance hierarchy one component at a time.
+ * Systems iterate the columns of every matching archetype linearly instead of calling into scattered objects.
+ * Handles are generational, a handle of a destroyed entity never resolves even after its index got reused.
+ */
+class EntityStore
+{
+
+private:
+
+    struct EntityRecord
+    {
+        uint32_t archetypeIndex = 0;
+        uint32_t row = 0;
+        uint32_t generation = 0;
+        bool bAlive = false;
+    };
+
+    std::vector<std::unique_ptr<EntityArchetype>> mArchetypes;
+    std::vector<EntityRecord> mEntities;
+    std::vector<uint32_t> mFreeEntityIndices;
+    uint32_t mEntityCount = 0;
+
+    uint32_t findOrCreateArchetype(ComponentMask mask);
+    const EntityRecord* findRecord(EntityHandle entity) const;
+
+public:
+
+    EntityHandle createEntity(ComponentMask mask);
+    void destroyEntity(EntityHandle entity);
+    bool isAlive(EntityHandle entity) const { return findRecord(entity); }
+
+    uint32_t getEntityCount() const { return mEntityCount; }
+    const std::vector<std::unique_ptr<EntityArchetype>>& getArchetypes() const { return mArchetypes; }
+
+    ComponentMask getComponentMask(EntityHandle entity) const;
+
+    /* Moves the entity to the archetype matching the new component set, invalidates component pointers */
+    void setComponentMask(EntityHandle entity, ComponentMask mask);
+
+    template<typename Component>
+    Component* getComponent(EntityHandle entity);
+
+    template<typename Component>
+    const Component* getComponent(EntityHandle entity) const;
+
+    template<typename Component>
+    Component& addComponent(EntityHandle entity, const Component& component = {});
+
+    template<typename Component>
+    void removeComponent(EntityHandle entity);
+
+    /* function(EntityHandle, Components&...) for every entity that has at least these components */
+    template<typename... Components, typename Function>
+    void forEach(Function&& function);
+
+    template<typename... Components, typename Function>
+    void forEach(Function&& function) const;
+
+};
+
+template<typename Component>
+Component* EntityStore::getComponent(const EntityHandle entity)
+{
+    return const_cast<Component*>(std::as_const(*this).getComponent<Component>(entity));
+}
+
+template<typename Component>
+const Component* EntityStore::getComponent(const EntityHandle entity) const
+{
+    const EntityRecord* record = findRecord(entity);
+    if (!record) return nullptr;
+
+    const EntityArchetype& archetype = *mArchetypes[record->archetypeIndex];
+    if (!archetype.hasComponents(getComponentBit<Component>())) return nullptr;
+
+    return &archetype.getColumn<Component>()[record->row];
+}
+
+template<typename Component>
+Component& EntityStore::addComponent(const EntityHandle entity, const Component& component)
+{
+    setComponentMask(entity, getComponentMask(entity) | getComponentBit<Component>());
+
+    Component* addedComponent = getComponent<Component>(entity);
+    *addedComponent = component;
+    return *addedComponent;
+}
+
+template<typename Component>
+void EntityStore::removeComponent(const EntityHandle entity)
+{
+    setComponentMask(entity, getComponentMask(entity) & ~getComponentBit<Component>());
+}
+
+template<typename... Components, typename Function>
+void EntityStore::forEach(Function&& function)
+{
+    constexpr ComponentMask mask = makeComponentMask<Components...>();
+
+    for (const std::unique_ptr<EntityArchetype>& archetype : mArchetypes)
+    {
+        if (!archetype->hasComponents(mask)) continue;
+
+        const uint32_t size = archetype->getSize();
+        for (uint32_t row = 0; row < size; ++row)
+        {
+            const uint32_t entityIndex = archetype->mEntityIndices[row];
+            const EntityHandle entity = {.index = entityIndex, .generation = mEntities[entityIndex].generation};
+            function(entity, archetype->getColumn<Components>()[row]...);
+        }
+    }
+}
+
+template<typename... Components, typename Function>
+void EntityStore::forEach(Function&& function) const
+{
+    constexpr ComponentMask mask = makeComponentMask<Components...>();
+
+    for (const std::unique_ptr<EntityArchetype>& archetype : mArchetypes)
+    {
+        if (!archetype->hasComponents(mask)) continue;
+
+        const EntityArchetype& constArchetype = *archetype;
+        const uint32_t size = constArchetype.getSize();
+        for (uint32_t row = 0; row < size; ++row)
+        {
+            const uint32_t entityIndex = constArchetype.mEntityIndices[row];
+            const EntityHandle entity = {.index = entityIndex, .generation = mEntities[entityIndex].generation};
+            function(entity, constArchetype.getColumn<Components>()[row]...);
+        }
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+class EntityStore;
+struct RenderPacket;
+struct Vector2;
+
+/* Transform + Body, no collision yet, bodies that need it stay CollisionObjects */
+void integrateEntityBodies(EntityStore& entityStore, float deltaTime);
+
+/* Transform + RenderMesh + Color, culled against the bounds when the entity has a Shape */
+void appendEntityRenderItems(const EntityStore& entityStore, RenderPacket& packet, const Vector2& viewLocation, const Vector2& windowSize);
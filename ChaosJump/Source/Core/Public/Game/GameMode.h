@@ -6,6 +6,13 @@
 #include "Networking/SerializableInterface.h"
 #include "SteamSDK/public/steam/steamnetworkingtypes.h"
 
+/* The name has to outlive the report it ends up in, in practice a string literal */
+struct ObjectCount
+{
+    const char* name = "";
+    uint32_t count = 0;
+};
+
 class GameMode : public SerializableInterface
 {
 
@@ -34,4 +41,7 @@ public:
     virtual void removePlayer(Player* player);
 
     const std::vector<Player*>& getPlayers() const { return mPlayers; }
+
+    /* Gameplay object counts for benchmark reports, on top of what Application counts itself */
+    virtual void appendObjectCounts(std::vector<ObjectCount>& outCounts) const;
 };
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Base/MappedFile.h"
+#include "Math/Vector2.h"
+#include "Render/DrawableInterface.h"
+
+class CollisionObject;
+
+enum class ScenarioBodyType : uint8_t
+{
+    Platform,
+    Circle,
+    Rectangle,
+    Polygon
+};
+
+/* Stored as is, the file is read straight from the mapping */
+struct ScenarioBody
+{
+    ScenarioBodyType type = ScenarioBodyType::Platform;
+    uint8_t padding[3] = {};
+    Color color = {};
+    Vector2 location = {};
+    Vector2 velocity = {};
+
+    /* Radius in x for circles, width and height for rectangles */
+    Vector2 size = {};
+
+    /* Polygons only, a range of Scenario::getVertices */
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+};
+
+struct ScenarioHeader
+{
+    char magic[4] = {};
+    uint16_t version = 0;
+    uint16_t headerSize = 0;
+    uint32_t bodyCount = 0;
+    uint32_t vertexCount = 0;
+    Vector2 playerSpawnLocation = {};
+};
+
+static_assert(std::is_trivially_copyable_v<ScenarioBody> && sizeof(ScenarioBody) == 48, "ScenarioBody is part of the file format");
+static_assert(std::is_trivially_copyable_v<ScenarioHeader> && sizeof(ScenarioHeader) == 24, "ScenarioHeader is part of the file format");
+
+/*
+ * Versioned binary world description: a header, the bodies and the polygon vertices they index, little endian.
+ * The file stays mapped while open, nothing is parsed or copied beyond the validation in open.
+ */
+class Scenario
+{
+
+public:
+
+    static constexpr char sMagic[4] = {'C', 'J', 'S', 'C'};
+    static constexpr uint16_t sVersion = 1;
+
+private:
+
+    MappedFile mFile;
+    const ScenarioHeader* mHeader = nullptr;
+    std::span<const ScenarioBody> mBodies = {};
+    std::span<const Vector2> mVertices = {};
+
+public:
+
+    /* Fails on foreign files, other versions and bodies indexing vertices out of range */
+    bool open(const char* path);
+    void close();
+
+    bool isOpen() const { return mHeader; }
+
+    const Vector2& getPlayerSpawnLocation() const { return mHeader->playerSpawnLocation; }
+    std::span<const ScenarioBody> getBodies() const { return mBodies; }
+    std::span<const Vector2> getVertices() const { return mVertices; }
+    std::span<const Vector2> getBodyVertices(const ScenarioBody& body) const { return mVertices.subspan(body.firstVertex, body.vertexCount); }
+
+};
+
+/* Collects the bodies of a live world and writes them as a scenario */
+class ScenarioWriter
+{
+
+private:
+
+    Vector2 mPlayerSpawnLocation = {};
+    std::vector<ScenarioBody> mBodies = {};
+    std::vector<Vector2> mVertices = {};
+
+public:
+
+    void setPlayerSpawnLocation(const Vector2& location) { mPlayerSpawnLocation = location; }
+
+    /* Platforms, circles, rectangles and polygons, returns false for anything else */
+    bool addBody(const CollisionObject& object);
+
+    bool write(const char* path) const;
+
+};
@@ -1,18 +1,38 @@
 #pragma once
 #include <map>
 
+#include "Base/TickableInterface.h"
 #include "SDL3/SDL_scancode.h"
 
+class InputReceiverInterface;
+
+/* Polls the held keys of its receiver in the parallel phase */
+class KeyTriggerTickable : public TickableInterface
+{
+
+private:
+
+    InputReceiverInterface& mInputReceiver;
+
+public:
+
+    explicit KeyTriggerTickable(InputReceiverInterface& inputReceiver);
+
+    void tick(float deltaTime) override;
+
+};
+
 class InputReceiverInterface
 {
 private:
     
     std::map<SDL_Scancode, bool> mKeyDownMap = {};
 
-protected:
-    
-    /* needs to be called by a TickableInterface object to support handleKeyTrigger */
-    void tick(float deltaTime);
+    KeyTriggerTickable mKeyTriggerTickable{*this};
+
+    friend class KeyTriggerTickable;
+
+    void pollKeyTriggers(float deltaTime);
     
 public:
 
@@ -20,6 +40,7 @@ public:
     
     virtual void handleKeyPressed(SDL_Scancode scancode);
     virtual void handleKeyReleased(SDL_Scancode scancode);
+    /* Called every frame per held key from the parallel phase, may only write the receiver's own state */
     virtual void handleKeyTrigger(SDL_Scancode scancode, float deltaTime);
     
     virtual ~InputReceiverInterface() = default;
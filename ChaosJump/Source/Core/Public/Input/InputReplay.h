@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <vector>
+
+#include "SDL3/SDL_scancode.h"
+
+class InputRouter;
+
+enum class InputReplayMode : uint8_t
+{
+    Off,
+    Recording,
+    Playing
+};
+
+/*
+ * Records the frame deltas, routed key events and world seeds of a session into a binary log and plays them back frame exactly.
+ * The log is a header followed by tagged records in native byte order, every frame starts with its delta:
+ *   Frame [float deltaSeconds], Key [uint16 scancode, uint8 pressed], Seed [uint32 seed]
+ * Only offline sessions reproduce, whatever arrives over the network isn't part of the log.
+ */
+class InputReplay
+{
+
+private:
+
+    enum class RecordType : uint8_t
+    {
+        Frame,
+        Key,
+        Seed
+    };
+
+    struct KeyEvent
+    {
+        SDL_Scancode scancode = SDL_SCANCODE_UNKNOWN;
+        bool bPressed = false;
+    };
+
+    static constexpr char sMagic[4] = {'C', 'J', 'R', 'P'};
+    static constexpr uint16_t sVersion = 1;
+
+    /* Recording flushes to the file once this much is buffered */
+    static constexpr size_t sFlushSize = 64 * 1024;
+
+    InputReplayMode mMode = InputReplayMode::Off;
+
+    /* Pending writes while recording, the whole log while playing */
+    std::vector<uint8_t> mBuffer;
+    size_t mReadOffset = 0;
+
+    std::ofstream mRecordFile;
+    uint64_t mFrameCount = 0;
+
+    std::vector<KeyEvent> mFrameKeyEvents;
+    std::deque<uint32_t> mPendingSeeds;
+
+    template<typename T>
+    void write(const T& value);
+
+    template<typename T>
+    bool read(T& outValue);
+
+    void flush();
+
+    /* Reads key and seed records until the next frame record */
+    void readEventRecords();
+
+public:
+
+    InputReplay() = default;
+    ~InputReplay();
+
+    InputReplay(const InputReplay&) = delete;
+    InputReplay& operator=(const InputReplay&) = delete;
+
+    bool startRecording(const char* path);
+    bool startPlayback(const char* path);
+
+    /* Flushes a recording, playback stops by itself at the end of the log */
+    void stop();
+
+    InputReplayMode getMode() const { return mMode; }
+    bool isPlaying() const { return mMode == InputReplayMode::Playing; }
+    uint64_t getFrameCount() const { return mFrameCount; }
+
+    /* Called once at the start of every frame, returns the delta the frame has to simulate */
+    float beginFrame(float deltaSeconds);
+
+    /* Routes the key events recorded for the current frame, live key events aren't routed while playing */
+    void routeFrameKeyEvents(InputRouter& inputRouter);
+
+    void recordKeyEvent(SDL_Scancode scancode, bool bPressed);
+
+    /* Every world seed goes through here, while playing it's replaced by the recorded one */
+    uint32_t resolveSeed(uint32_t seed);
+
+};
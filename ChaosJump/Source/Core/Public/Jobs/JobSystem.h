@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Counts the unfinished jobs it was passed to, JobSystem::wait blocks on it while helping out. */
+class JobCounter
+{
+
+private:
+
+    std::atomic<uint32_t> mPendingJobs = 0;
+
+    friend class JobSystem;
+
+public:
+
+    bool isDone() const { return mPendingJobs.load(std::memory_order_acquire) == 0; }
+
+};
+
+/*
+ * Work-stealing scheduler. Every worker and the main thread own a deque, owners push and pop at the back,
+ * idle threads steal from the front of the others.
+ * Queue 0 belongs to the thread that created the JobSystem, it only runs jobs while waiting.
+ */
+class JobSystem
+{
+
+private:
+
+    struct Job
+    {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+    std::vector<std::thread> mWorkers;
+
+    std::atomic<bool> bRunning = true;
+    std::atomic<uint32_t> mQueuedJobCount = 0;
+
+    std::mutex mWakeMutex;
+    std::condition_variable mWakeCondition;
+
+    /* Notified whenever a counter reaches zero, waiters with nothing left to steal sleep on it */
+    std::mutex mCompletionMutex;
+    std::condition_variable mCompletionCondition;
+
+    static thread_local uint32_t sQueueIndex;
+
+    bool popJob(uint32_t queueIndex, Job& outJob);
+    bool stealJob(uint32_t thiefIndex, Job& outJob);
+    bool tryRunJob();
+    void runJob(Job& job);
+
+    void workerLoop(uint32_t queueIndex);
+
+public:
+
+    /* 0 workers runs every job on the waiting thread */
+    JobSystem(uint32_t workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+    /* Number of threads that execute jobs, including the one waiting */
+    uint32_t getThreadCount() const { return getWorkerCount() + 1; }
+
+    static uint32_t getDefaultWorkerCount();
+
+    void schedule(std::function<void()> function, JobCounter* counter = nullptr);
+
+    /* Runs queued jobs on the calling thread until counter is done, sleeps once there is nothing left to take. */
+    void wait(const JobCounter& counter);
+
+    /**
+     * Calls function(begin, end) for batches of [0, count) across all threads and returns once every batch ran.
+     * \param batchSize 0 splits the range evenly across the threads
+     */
+    template<typename Function>
+    void parallelFor(uint32_t count, uint32_t batchSize, Function&& function);
+
+};
+
+template<typename Function>
+void JobSystem::parallelFor(const uint32_t count, uint32_t batchSize, Function&& function)
+{
+    if (!count) return;
+
+    if (!batchSize)
+    {
+        const uint32_t threadCount = getThreadCount();
+        batchSize = (count + threadCount - 1) / threadCount;
+    }
+
+    if (batchSize >= count)
+    {
+        function(0u, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (uint32_t begin = batchSize; begin < count; begin += batchSize)
+    {
+        const uint32_t end = std::min(begin + batchSize, count);
+        schedule([&function, begin, end]()
+        {
+            function(begin, end);
+        }, &counter);
+    }
+
+    function(0u, batchSize);
+    wait(counter);
+}
@@ -1,6 +1,8 @@
 ﻿#pragma once
 
+#include <chrono>
 #include <functional>
+#include <future>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -9,6 +11,14 @@
 #include "Networking/SerializableInterface.h"
 #include "SteamSDK/public/steam/steam_api.h"
 
+enum class SteamState : uint8_t
+{
+    /* Steam isn't running or login failed, retried every sSteamInitRetrySeconds */
+    Unavailable,
+    Initializing,
+    Initialized
+};
+
 struct RemoteObjectDeleter
 {
     void operator()(SerializableInterface* serializableObject) const;
@@ -21,6 +31,11 @@ private:
 
     bool bSteamInitialized = false;
 
+    /* SteamAPI_Init runs here so a missing Steam client never blocks a frame */
+    std::future<bool> mSteamInitResult;
+    std::chrono::steady_clock::time_point mNextSteamInitAttempt = {};
+    static constexpr float sSteamInitRetrySeconds = 5.f;
+
     std::unordered_set<uint32_t> mUsedNetGUIDs;
 
     mutable std::vector<std::unique_ptr<SerializableInterface, RemoteObjectDeleter>> mRemotelyCreatedObjects;
@@ -38,7 +53,6 @@ private:
     HSteamNetConnection mServerConnection;
     uint64_t mLastHeartbeat = 0;
 
-    const uint64_t mReplicationTickRateMilliseconds = 4;
     mutable uint64_t mLastReplicateTimestamp = 0;
 
 protected:
@@ -49,6 +63,9 @@ protected:
     void replicateObject(const SerializableInterface* object) const;
     void replicateObjects() const;
 
+    void finishSteamInitialization();
+    void openListenSocket();
+
     SerializableInterface* createRemoteObject(uint8_t typeId, uint32_t uint32_t) const;
     void handleObjectNetPacket(const NetPacket& packet, HSteamNetConnection sendingConnection) const;
     void handleNetPacket(const NetPacket& packet, HSteamNetConnection sendingConnection) const;
@@ -60,14 +77,21 @@ public:
     NetHandler();
     virtual ~NetHandler();
 
-    bool initializeSteam();
+    /* Starts initializing Steam in the background, everything else works offline until it's done */
+    void beginSteamInitialization();
+
+    /* Polled every frame on the main thread, finishes a successful initialization and retries a failed one */
+    void updateSteamInitialization();
+
+    SteamState getSteamState() const;
+    bool isSteamInitialized() const { return bSteamInitialized; }
     
     void hostSession();
     void closeSession();
     void closeServerConnection();
     
     void openInviteDialogue() const;
-    static void openFriendslist();
+    void openFriendslist() const;
     
     bool isHosting() const { return bHosting; }
     bool isConnectedAsClient() const { return bConnectedAsClient; }
@@ -1,7 +1,7 @@
 #pragma once
 #include "Physics/CollisionObject.h"
 #include "Render/DrawableInterface.h"
-#include "SDL3/SDL_render.h"
+#include "Render/RenderPacket.h"
 
 class Circle : public CollisionObject, public DrawableInterface
 {
@@ -10,15 +10,16 @@ private:
 
     float mRadius = 0.f;
     
-    std::vector<SDL_Vertex> mVertices = {};
-    std::vector<int> mIndices = {};
+    std::shared_ptr<const RenderMesh> mMesh = nullptr;
     
 public:
 
     Circle(float radius);
 
+    float getRadius() const { return mRadius; }
+
     //~ Begin DrawableInterface Interface
-    void draw(SDL_Renderer* renderer, const Vector2& viewLocation) override;
+    void appendRenderItem(RenderPacket& packet, const Vector2& viewLocation) const override;
     bool shouldBeCulled(const Vector2& viewLocation, const Vector2& windowSize) const override;
     //~ End DrawableInterface Interface
     
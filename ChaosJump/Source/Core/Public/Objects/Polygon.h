@@ -1,24 +1,30 @@
 #pragma once
+#include <span>
+#include <vector>
+
 #include "Physics/CollisionObject.h"
 #include "Render/DrawableInterface.h"
-#include "SDL3/SDL_render.h"
+#include "Render/RenderPacket.h"
 
 class Polygon : public CollisionObject, public DrawableInterface
 {
 
 private:
 
-    std::vector<SDL_Vertex> mVertices = {};
-    std::vector<int> mIndices = {};
+    std::shared_ptr<const RenderMesh> mMesh = nullptr;
 
     float mFurthestVertexDistance = 0.f;
 
 public:
 
-    Polygon(const std::vector<Vector2>& vertices);
+    /* Scenario files pass their mapped vertices, nothing has to be copied into a vector first */
+    Polygon(std::span<const Vector2> vertices);
+
+    /* Relative to the location, as passed to the constructor */
+    const std::vector<Vector2>& getVertices() const;
 
     //~ Begin DrawableInterface Interface
-    void draw(SDL_Renderer* renderer, const Vector2& viewLocation) override;
+    void appendRenderItem(RenderPacket& packet, const Vector2& viewLocation) const override;
     bool shouldBeCulled(const Vector2& viewLocation, const Vector2& windowSize) const override;
     //~ End DrawableInterface Interface
     
@@ -16,8 +16,11 @@ public:
 
     Rectangle(float width, float height);
 
+    float getWidth() const { return mWidth; }
+    float getHeight() const { return mHeight; }
+
     //~ Begin DrawableInterface Interface
-    void draw(SDL_Renderer* renderer, const Vector2& viewLocation) override;
+    void appendRenderItem(RenderPacket& packet, const Vector2& viewLocation) const override;
     bool shouldBeCulled(const Vector2& viewLocation, const Vector2& windowSize) const override;
     //~ End DrawableInterface Interface
     
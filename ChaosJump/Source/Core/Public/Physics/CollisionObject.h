@@ -1,7 +1,6 @@
 #pragma once
 #include <map>
 #include <memory>
-#include <unordered_set>
 #include <vector>
 
 #include "CollisionShapeInterface.h"
@@ -25,6 +24,9 @@ enum class CollisionResponse : uint32_t
     Block
 };
 
+/* Exponential damping of a velocity, shared with the entity bodies so both kinds of bodies slow down the same */
+Vector2 applyDamping(const Vector2& velocity, const Vector2& dampingPerSecond, float deltaTime);
+
 struct CollisionResponseConfig
 {
     mutable std::map<CollisionCategory, CollisionResponse> collisionResponseMap;
@@ -59,6 +61,10 @@ private:
 
     CollisionCategory mCollisionCategory = CollisionCategory::Obstacle;
 
+    /* Never reused, unlike the address once pools hand a destroyed body's slot to the next one */
+    uint64_t mBodyId = 0;
+    static uint64_t sNextBodyId;
+
 protected:
 
     Vector2 mVelocity = {.x = 0, .y = 0};
@@ -66,13 +72,20 @@ protected:
     Vector2 mGravity = {.x = 0, .y = 981.f};
     
     Vector2 mDampingPerSecond = {.x = 0, .y = 0};
+
+    /* Direction bodies may pass through this one, zero means it blocks from every side. */
+    Vector2 mOneWayPassDirection = {.x = 0, .y = 0};
     
     std::unique_ptr<CollisionShapeInterface> mCollisionShape = nullptr;
 
     uint64_t mLastMoveFrame = 0 - 1;
+    /* Result of the move in mLastMoveFrame, kept for the PhysicsRecorder */
+    CollisionResult mLastMoveResult = {};
 
     static std::map<CollisionCategory, CollisionResponseConfig> sDefaultCollisionResponseConfigs;
+    /* Unordered, every body knows its slot so leaving a bucket is a swap with the last body */
     static std::map<CollisionCategory, std::vector<CollisionObject*>> sCollisionCategoryBuckets;
+    uint32_t mBucketIndex = 0;
 
     CollisionResponseConfig mCollisionResponseConfig = {};
     
@@ -81,6 +94,12 @@ public:
     CollisionObject();
     ~CollisionObject() override; 
 
+    // The bucket slot and body id belong to this instance, a copy would free the slot when destroyed.
+    CollisionObject(const CollisionObject&) = delete;
+    CollisionObject& operator=(const CollisionObject&) = delete;
+
+    uint64_t getBodyId() const { return mBodyId; }
+
     CollisionShapeInterface* getCollisionShape() const { return mCollisionShape.get(); }
     void setCollisionShape(CollisionShapeInterface* inCollisionShape);
 
@@ -95,6 +114,9 @@ public:
     void setGravity(const Vector2& inGravity);
     void setCanMove(bool inCanMove);
 
+    bool isOneWay() const { return !mOneWayPassDirection.isAlmostZero(); }
+    void setOneWayPassDirection(const Vector2& inPassDirection);
+
     const Vector2& getLocation() const { return mLocation; }
     void setLocation(const Vector2& inLocation);
     
@@ -115,14 +137,22 @@ public:
 
 private:
 
-    std::unordered_set<CollisionObject*> mOverlappingObjects;
-    std::map<CollisionObject*, size_t> mOverlapDestroyEventIds;
+    /* Flat on purpose, a body rarely overlaps more than a handful of others and PhysicsSnapshot copies it as is. */
+    std::vector<CollisionObject*> mOverlappingObjects;
+    std::map<CollisionObject*, EventHandle> mOverlapDestroyEventIds;
+
+    friend class PhysicsSnapshot;
+    friend class PhysicsRecorder;
 
 protected:
 
+    bool isOverlappingObject(const CollisionObject* inCollisionObject) const;
+    bool canPassThroughOneWay(const CollisionObject* oneWayObject, const Vector2& collisionNormal) const;
+
     void insertOverlappingObject(CollisionObject* inCollisionObject);
     void removeOverlappingObject(CollisionObject* inCollisionObject);
 
+    void addToBucket();
     void removeFromBucket();
 
     void handleCollision(const CollisionResult& collisionResult);
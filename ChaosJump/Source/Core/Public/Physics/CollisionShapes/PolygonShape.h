@@ -1,6 +1,8 @@
 #pragma once
+#include <span>
 #include <vector>
 
+#include "Base/FrameArena.h"
 #include "Physics/CollisionShapeInterface.h"
 
 class PolygonShape : public CollisionShapeInterface
@@ -18,7 +20,7 @@ public:
 
     
     Vector2 getVertexClosestToRelativeLocation(const Vector2& location) const;
-    void getNormals(std::vector<Vector2>& outNormals) const;
+    void getNormals(TFrameVector<Vector2>& outNormals) const;
 
     struct Extremes
     {
@@ -28,7 +30,9 @@ public:
     
     Extremes getExtremesOnNormal(const Vector2& location, const Vector2& normal) const;
     
-    PolygonShape(const std::vector<Vector2>& vertices);
+    PolygonShape(std::span<const Vector2> vertices);
+
+    const std::vector<Vector2>& getVertices() const { return mVertices; }
 
     //~ Being CollisionShapeInterface Interface
     CollisionResult isCollidingWithWindowBorderAtLocation(const Vector2& shapeLocation, const Vector2& viewLocation, const Vector2& windowSize) override;
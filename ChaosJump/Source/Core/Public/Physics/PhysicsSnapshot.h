@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Math/Vector2.h"
+
+class CollisionObject;
+enum class CollisionCategory : uint32_t;
+
+/*
+ * Copies the simulation state of every CollisionObject into flat arrays so it can be restored later
+ * (rollback, match resets, what-if simulation). Capturing and restoring don't allocate once the buffers are warm.
+ * Only bodies that are alive on capture and on restore are touched, spawning and destroying objects is not rolled back.
+ * Bodies are matched by address and body id, so a body that took over a destroyed one's pool slot is left alone.
+ */
+class PhysicsSnapshot
+{
+
+private:
+
+    struct BodyState
+    {
+        CollisionObject* body = nullptr;
+        uint64_t bodyId = 0;
+
+        Vector2 location;
+        Vector2 velocity;
+        Vector2 gravity;
+        Vector2 dampingPerSecond;
+        Vector2 oneWayPassDirection;
+
+        float area = 1.f;
+        float density = 1.f;
+        uint64_t lastMoveFrame = 0;
+
+        CollisionCategory category;
+        uint8_t collisionResponses[3] = {};
+
+        bool bCanMove = true;
+        bool bCollideWindowX = true;
+        bool bCollideWindowY = true;
+
+        uint32_t overlapBegin = 0;
+        uint32_t overlapCount = 0;
+    };
+
+    struct OverlapState
+    {
+        /* nullptr is an overlap with the window border */
+        CollisionObject* body = nullptr;
+        uint64_t bodyId = 0;
+    };
+
+    std::vector<BodyState> mBodyStates = {};
+    std::vector<OverlapState> mOverlaps = {};
+
+    /* body -> index into mBodyStates, only built when the live bodies don't line up with the captured ones */
+    mutable std::vector<std::pair<const CollisionObject*, uint32_t>> mBodyLookup = {};
+    mutable std::vector<std::pair<const CollisionObject*, uint64_t>> mLiveBodies = {};
+    mutable bool bBodyLookupDirty = true;
+
+    /* nullptr when the body at that address isn't the captured one */
+    const BodyState* findBodyState(const CollisionObject* body) const;
+    bool isBodyAlive(const OverlapState& overlap) const;
+
+    void applyBodyState(const BodyState& state, bool bValidateOverlaps) const;
+
+public:
+
+    void capture();
+    void restore() const;
+    void clear();
+
+    bool isEmpty() const { return mBodyStates.empty(); }
+    size_t getBodyCount() const { return mBodyStates.size(); }
+    size_t getByteSize() const;
+
+};
@@ -8,7 +8,7 @@ struct Color
     float r,g,b;
 };
 
-class SDL_Renderer;
+struct RenderPacket;
 
 class DrawableInterface
 {
@@ -16,19 +16,34 @@ class DrawableInterface
 private:
 
     Color mColor = {.r = 0, .g = 0, .b = 0};
+
+    /* Slot in sDrawables, destroying only nulls it so removal is O(1) and the draw order stays stable */
+    uint32_t mDrawableIndex = 0;
+
+    static bool bDrawablesHaveHoles;
+    friend class Application;
+
+    /* Drops the nulled slots in a single pass, called before the drawables are extracted */
+    static void compactDrawables();
     
 public:
 
     DrawableInterface(Color color);
 
+    // The registry slot belongs to this instance, a copy would free it when destroyed.
+    DrawableInterface(const DrawableInterface&) = delete;
+    DrawableInterface& operator=(const DrawableInterface&) = delete;
+
     const Color& getColor() const { return mColor; }
     void setColor(Color color);
 
+    /* Drawn in registration order, so later drawables end up on top */
     static std::vector<DrawableInterface*> sDrawables;
     
     virtual ~DrawableInterface();
 
-    virtual void draw(SDL_Renderer* renderer, const Vector2& viewLocation) = 0;
+    /* Called at the end of the tick, anything the renderer needs has to be copied into the packet. */
+    virtual void appendRenderItem(RenderPacket& packet, const Vector2& viewLocation) const = 0;
     virtual bool shouldBeCulled(const Vector2& viewLocation, const Vector2& windowSize) const = 0;
     
 };
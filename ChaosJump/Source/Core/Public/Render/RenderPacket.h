@@ -0,0 +1,74 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Math/Vector2.h"
+#include "Render/DrawableInterface.h"
+#include "SDL3/SDL_render.h"
+
+struct DebugLine
+{
+    Vector2 start;
+    Vector2 end;
+    Color color;
+    float duration = 0.f;
+};
+
+struct DisplayText
+{
+    /*TopLeft window border = {-1, -1}, bottom right = {1, 1}*/
+    Vector2 screenPosition = {};
+    std::string text;
+    Color color = {1, 1, 1};
+    float duration = 0.f;
+    Vector2 textScale = {1, 1};
+
+    /* TopLeft Text border = {-1, -1}, bottom right = {1, 1}
+     * This is the position in the DisplayText that aligns with the screenPosition.
+     */
+    Vector2 alignment = {};
+};
+
+/* Vertices are relative to the drawable's location. Never modified after creation so the render thread can read it while the owner dies. */
+struct RenderMesh
+{
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+};
+
+enum class RenderItemType : uint8_t
+{
+    FilledRect,
+    Geometry
+};
+
+struct RenderItem
+{
+    RenderItemType type = RenderItemType::FilledRect;
+    Vector2 screenLocation = {};
+    Color color = {.r = 0, .g = 0, .b = 0};
+
+    /* FilledRect only */
+    Vector2 size = {};
+
+    /* Geometry only */
+    std::shared_ptr<const RenderMesh> mesh = nullptr;
+};
+
+/* Everything drawFrame needs to render a frame, extracted from the simulation at the end of the tick. */
+struct RenderPacket
+{
+    std::vector<RenderItem> items;
+    std::vector<DebugLine> debugLines;
+    std::vector<DisplayText> displayTexts;
+
+    /* Screen space line strip of the recent frame times and pairs of reference line points, empty when the graph is off */
+    std::vector<SDL_FPoint> frameTimeGraph;
+    std::vector<SDL_FPoint> frameTimeGraphReferences;
+
+    Vector2 viewLocation = {};
+
+    /* Keeps the capacity so extraction doesn't allocate once warmed up */
+    void reset();
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Math/Vector2.h"
+#include "Render/RenderPacket.h"
+
+struct SDL_Texture;
+
+/*
+ * Rasterizes display texts once into a shared atlas texture and draws all of them with a single geometry call.
+ * Strings are rasterized white at scale 1, color and scale are applied by the quads so they don't fragment the cache.
+ * Once the atlas is full it is cleared and the texts still in use get rasterized again.
+ * Render thread only.
+ */
+class TextCache
+{
+
+public:
+
+    static constexpr int sAtlasWidth = 4096;
+    static constexpr int sAtlasHeight = 512;
+
+private:
+
+    /* One row per string, the glyphs are 8x8 and a pixel of padding keeps scaled neighbours from bleeding in */
+    static constexpr int sRowHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 1;
+
+    SDL_Renderer* mRenderer = nullptr;
+    SDL_Texture* mAtlas = nullptr;
+
+    /* Atlas rect of every rasterized string, without the padding */
+    using EntryMap = std::unordered_map<std::string, SDL_FRect>;
+    EntryMap mEntries = {};
+
+    /* Where the next string goes */
+    float mCursorX = 0.f;
+    float mCursorY = 0.f;
+
+    bool bAtlasDirty = true;
+
+    /* Entries added this frame that still have to be rasterized, reused every frame */
+    std::vector<const EntryMap::value_type*> mPendingEntries = {};
+
+    std::vector<SDL_Vertex> mVertices = {};
+    std::vector<int> mIndices = {};
+
+public:
+
+    /* Without render target support every text is drawn directly like before */
+    explicit TextCache(SDL_Renderer* renderer);
+    ~TextCache();
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    void drawTexts(const std::vector<DisplayText>& texts, const Vector2& windowSize);
+
+    /* Forgets every entry, needed once the renderer lost the atlas contents after a render target reset */
+    void clear();
+
+private:
+
+    /* Returns false when the atlas has no room left for the size */
+    bool allocate(float width, SDL_FRect& outRect);
+
+    /* Adds the missing texts to the atlas, wider than the atlas ones are left out and drawn directly */
+    void cacheTexts(const std::vector<DisplayText>& texts);
+
+    void rasterizePendingEntries();
+
+};
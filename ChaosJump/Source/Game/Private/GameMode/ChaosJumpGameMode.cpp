@@ -3,18 +3,41 @@
 #include <format>
 
 #include "Application.h"
+#include "Base/ConsoleVariable.h"
 #include "Base/HelperDefinitions.h"
 #include "Debugging/DebugDefinitions.h"
+#include "Debugging/Logger.h"
+#include "Game/Scenario.h"
 #include "GameMode/ChunkGenerator.h"
+#include "Input/InputReplay.h"
 #include "Networking/NetHandler.h"
+#include "Objects/Circle.h"
 #include "Objects/Platform.h"
+#include "Objects/Polygon.h"
+#include "Objects/Rectangle.h"
 #include "Player/ChaosJumpPlayer.h"
 #include "SDL3/SDL_render.h"
 
 DEFINE_DEFAULT_DELETER(ChunkGenerator)
+DEFINE_DEFAULT_DELETER(Scenario)
 
-Vector2 ChaosJumpGameMode::sPlayerSpawnLocation = {.x = 0, .y = 200};
-uint32_t ChaosJumpGameMode::sPlatformsPerChunk = 8;
+static const Vector2 sDefaultPlayerSpawnLocation = {.x = 0, .y = 200};
+Vector2 ChaosJumpGameMode::sPlayerSpawnLocation = sDefaultPlayerSpawnLocation;
+
+// Read when a round starts, so a round stays reproducible from its seed.
+static TConsoleVariable<uint32_t> sPlatformsPerChunk("game.PlatformsPerChunk", 8, "Platforms generated per chunk, applies from the next round");
+static TConsoleVariable<uint32_t> sObstaclesPerChunk("game.ObstaclesPerChunk", 1, "Obstacles generated per chunk, applies from the next round");
+
+/* The menu only polls for a game start and redraws its texts, which stay up until the next tick */
+static constexpr float sMenuTickSeconds = 0.1f;
+/*
+ * Text age already counts the frame the text was added in while the next tick only counts the frames after it,
+ * with uneven frame times the texts would expire before being replaced. The overlap draws the same string on top of itself.
+ */
+static constexpr float sMenuTextSeconds = sMenuTickSeconds * 1.5f;
+
+static TConsoleVariable<uint32_t> sFarObstacleTickFrames("game.FarObstacleTickFrames", 4, "Obstacles outside the view tick every this many frames with the accumulated delta, 1 ticks them every frame");
+static TConsoleVariable<float> sObstacleKeepChunks("game.ObstacleKeepChunks", 3.f, "Obstacles further than this many chunks below the view are destroyed");
 
 void ChaosJumpPlayerDeleter::operator()(ChaosJumpPlayer* player) const
 {
@@ -24,46 +47,101 @@ void ChaosJumpPlayerDeleter::operator()(ChaosJumpPlayer* player) const
 
 void ChaosJumpGameMode::setSeed(const uint32_t inSeed)
 {
-    mSeed = inSeed;
+    mSeed = Application::getApplication().getInputReplay()->resolveSeed(inSeed);
 
     mPlatforms.clear();
     mObstacles.clear();
+    sPlayerSpawnLocation = sDefaultPlayerSpawnLocation;
 
-    std::unique_ptr<Platform> platform = std::make_unique<Platform>();
+    TPooledPtr<Platform> platform = mPlatformPool.create<Platform>();
     platform->setLocation(sPlayerSpawnLocation + Vector2{.x = 0, .y = 300});
     mPlatforms.push_back(std::move(platform));
 
     const Vector2& windowSize = Application::getApplication().getWindowSize();
-    mChunkGenerator = std::unique_ptr<ChunkGenerator, ChunkGeneratorDeleter>(new ChunkGenerator(windowSize, sPlatformsPerChunk, mSeed));
+    mChunkGenerator = std::unique_ptr<ChunkGenerator, ChunkGeneratorDeleter>(new ChunkGenerator(windowSize, sPlatformsPerChunk.get(), sObstaclesPerChunk.get(), mSeed, mPlatformPool, mObstaclePool));
 
     mChunkGenerator->generateChunk(0, mPlatforms, mObstacles);
 }
 
-void ChaosJumpGameMode::clearDroppedPlatforms(const float currentHeight)
+template<typename T>
+static TPooledPtr<CollisionObject> setupScenarioObstacle(TPooledPtr<T> obstacle, const ScenarioBody& body)
+{
+    // Same setup as the chunk generator gives its obstacles.
+    obstacle->setColor(body.color);
+    obstacle->setCanCollideWithWindowBorder(true, true);
+    obstacle->setGravity({});
+    obstacle->setLocation(body.location);
+    obstacle->setVelocity(body.velocity);
+
+    return obstacle;
+}
+
+void ChaosJumpGameMode::loadScenario()
 {
-    std::vector<int> droppedPlatformIndices = {};
-    const size_t platformCount = mPlatforms.size(); 
-    for (size_t i = platformCount - 1; i < std::numeric_limits<size_t>::max(); --i)
+    mChunkGenerator.reset();
+    mPlatforms.clear();
+    mObstacles.clear();
+    sPlayerSpawnLocation = mScenario->getPlayerSpawnLocation();
+
+    const std::span<const ScenarioBody> bodies = mScenario->getBodies();
+    mObstacles.reserve(bodies.size());
+
+    for (const ScenarioBody& body : bodies)
     {
-        auto& platform = mPlatforms[i];
-        if (platform->getLocation().y > currentHeight + mChunkHeight)
+        switch (body.type)
         {
-            mPlatforms.erase(mPlatforms.begin() + i);
+        case ScenarioBodyType::Platform:
+            {
+                TPooledPtr<Platform> platform = mPlatformPool.create<Platform>();
+                platform->setLocation(body.location);
+                platform->setColor(body.color);
+                mPlatforms.push_back(std::move(platform));
+            }
+            break;
+        case ScenarioBodyType::Circle:
+            mObstacles.push_back(setupScenarioObstacle(mObstaclePool.create<Circle>(body.size.x), body));
+            break;
+        case ScenarioBodyType::Rectangle:
+            mObstacles.push_back(setupScenarioObstacle(mObstaclePool.create<Rectangle>(body.size.x, body.size.y), body));
+            break;
+        case ScenarioBodyType::Polygon:
+            mObstacles.push_back(setupScenarioObstacle(mObstaclePool.create<Polygon>(mScenario->getBodyVertices(body)), body));
+            break;
         }
     }
 }
 
+void ChaosJumpGameMode::clearDroppedPlatforms(const float currentHeight)
+{
+    // Single pass, erasing one by one from the middle moved the tail for every dropped platform.
+    std::erase_if(mPlatforms, [this, currentHeight](const TPooledPtr<Platform>& platform)
+    {
+        return platform->getLocation().y > currentHeight + mChunkHeight;
+    });
+}
+
 void ChaosJumpGameMode::clearObstaclesOutOfRange(const float currentHeight)
 {
-    std::vector<int> outOfRangeObstaclesIndices = {};
-    const size_t obstacleCount = mObstacles.size(); 
-    for (size_t i = obstacleCount - 1; i < std::numeric_limits<size_t>::max(); --i)
+    const float keepDistance = sObstacleKeepChunks.get() * mChunkHeight;
+
+    std::erase_if(mObstacles, [currentHeight, keepDistance](const TPooledPtr<CollisionObject>& obstacle)
     {
-        auto& obstacle = mObstacles[i];
-        if (obstacle->getLocation().y > currentHeight + 3 * mChunkHeight)
-        {
-            mObstacles.erase(mObstacles.begin() + i);
-        }
+        return obstacle->getLocation().y > currentHeight + keepDistance;
+    });
+}
+
+void ChaosJumpGameMode::updateObstacleTickRates(const float viewHeight)
+{
+    const float margin = mChunkHeight / 2;
+    const float nearTop = viewHeight - margin;
+    const float nearBottom = viewHeight + mChunkHeight + margin;
+    const uint32_t farTickFrames = sFarObstacleTickFrames.get();
+
+    for (const TPooledPtr<CollisionObject>& obstacle : mObstacles)
+    {
+        const float obstacleHeight = obstacle->getLocation().y;
+        const bool bNearView = obstacleHeight >= nearTop && obstacleHeight <= nearBottom;
+        obstacle->setTickFrameInterval(bNearView ? 1 : farTickFrames);
     }
 }
 
@@ -80,6 +158,7 @@ void ChaosJumpGameMode::drawMenuDisplayText() const
             .screenPosition = {.x = 0, .y = -0.25},
             .text = "Waiting for another player to join.",
             .color = {.r = 1, .g = 0, .b = 0},
+            .duration = sMenuTextSeconds,
             .textScale = {.x = 4, .y = 4}
         };
 
@@ -88,6 +167,7 @@ void ChaosJumpGameMode::drawMenuDisplayText() const
             .screenPosition = {.x = 0, .y = 0.1},
             .text = "Press I to open Invite Dialogue, press C to close Session.",
             .color = {.r = 1, .g = 0, .b = 0},
+            .duration = sMenuTextSeconds,
             .textScale = {.x = 3, .y = 3}
         };
 
@@ -101,20 +181,37 @@ void ChaosJumpGameMode::drawMenuDisplayText() const
             .screenPosition = {.x = 0, .y = -0.25},
             .text = "Chaos Jump",
             .color = {.r = 1, .g = 0, .b = 0},
+            .duration = sMenuTextSeconds,
             .textScale = {.x = 4, .y = 4}
         };
 
         const DisplayText infoDisplayText
         {
             .screenPosition = {.x = 0, .y = 0.1},
-            .text = "Press H to host Game, press F to open friends list.",
+            .text = "Press P to play solo, press H to host Game, press F to open friends list.",
             .color = gameSeconds % 2 ? Color{1, 1, 1} : Color{0, 1, 0},
+            .duration = sMenuTextSeconds,
             .textScale = {.x = 1.5, .y = 1.5}
         };
         
         app.addDisplayText(titleDisplayText);
         app.addDisplayText(infoDisplayText);
     }
+
+    const SteamState steamState = app.getNetHandler()->getSteamState();
+    if (steamState != SteamState::Initialized && !app.isHeadless())
+    {
+        const DisplayText steamStateText
+        {
+            .screenPosition = {.x = 0, .y = 0.35f},
+            .text = steamState == SteamState::Initializing ? "Connecting to Steam..." : "Steam isn't available, retrying. Solo play works offline.",
+            .color = {.r = 0.6f, .g = 0.6f, .b = 0.6f},
+            .duration = sMenuTextSeconds,
+            .textScale = {.x = 1.25, .y = 1.25}
+        };
+
+        app.addDisplayText(steamStateText);
+    }
 }
 
 void ChaosJumpGameMode::drawGameHUD(float deltaTime)
@@ -123,7 +220,7 @@ void ChaosJumpGameMode::drawGameHUD(float deltaTime)
     const DisplayText obstacleAliveCount
     {
         .screenPosition = {.x = -0.95f, .y = -0.95f},
-        .text = std::format("Obstacles alive: {}", mObstacles.size()),
+        .text = std::format("Obstacles alive: {} (pool {}/{})", mObstacles.size(), mObstaclePool.getStats().liveCount, mObstaclePool.getStats().capacity),
         .color = {.r = 1, .g = 1, .b = 1},
         .textScale = {.x = 1.25, .y = 1.25},
         .alignment = {.x = -1, .y = -1}
@@ -190,7 +287,13 @@ void ChaosJumpGameMode::drawGameHUD(float deltaTime)
     }
 }
 
-ChaosJumpGameMode::ChaosJumpGameMode() = default;
+ChaosJumpGameMode::ChaosJumpGameMode() : TickableInterface(TickPhase::PrePhysics),
+    mPlatformPool(sizeof(Platform), 64),
+    mObstaclePool(ObjectPool::getSlotSizeFor<Circle, Rectangle, Polygon>(), 16)
+{
+    setTickInterval(sMenuTickSeconds);
+}
+
 ChaosJumpGameMode::~ChaosJumpGameMode() = default;
 
 std::string ChaosJumpGameMode::handleJoiningConnection(const HSteamNetConnection connection)
@@ -233,6 +336,54 @@ void ChaosJumpGameMode::removePlayer(Player* player)
     std::erase(mChaosJumpPlayers, static_cast<ChaosJumpPlayer*>(player));
 }
 
+void ChaosJumpGameMode::appendObjectCounts(std::vector<ObjectCount>& outCounts) const
+{
+    GameMode::appendObjectCounts(outCounts);
+
+    outCounts.push_back({.name = "platforms", .count = static_cast<uint32_t>(mPlatforms.size())});
+    outCounts.push_back({.name = "obstacles", .count = static_cast<uint32_t>(mObstacles.size())});
+    outCounts.push_back({.name = "platformPoolCapacity", .count = mPlatformPool.getStats().capacity});
+    outCounts.push_back({.name = "obstaclePoolCapacity", .count = mObstaclePool.getStats().capacity});
+}
+
+void ChaosJumpGameMode::startLocalGame(const uint32_t seed)
+{
+    mSeedSequence.emplace(seed);
+    bWantsToStartGame = true;
+}
+
+bool ChaosJumpGameMode::startScenario(const char* path)
+{
+    std::unique_ptr<Scenario, ScenarioDeleter> scenario(new Scenario());
+    if (!scenario->open(path))
+    {
+        LOG(Error, "Couldn't load scenario {}", path);
+        return false;
+    }
+
+    mScenario = std::move(scenario);
+    bWantsToStartGame = true;
+    return true;
+}
+
+bool ChaosJumpGameMode::writeScenario(const char* path) const
+{
+    ScenarioWriter writer;
+    writer.setPlayerSpawnLocation(sPlayerSpawnLocation);
+
+    for (const TPooledPtr<Platform>& platform : mPlatforms)
+    {
+        writer.addBody(*platform);
+    }
+
+    for (const TPooledPtr<CollisionObject>& obstacle : mObstacles)
+    {
+        writer.addBody(*obstacle);
+    }
+
+    return writer.write(path);
+}
+
 void ChaosJumpGameMode::evaluateScoringPlayer()
 {
     if (!ensure(isLocallyOwned())) return;
@@ -256,12 +407,14 @@ void ChaosJumpGameMode::evaluateScoringPlayer()
     }
 
     bWantsToReset = true;
-    const NetPacket replicatePacket(this);
 
+    // Built per remote connection, packets need Steam which offline games never initialize.
     for (HSteamNetConnection connection : getJoinedConnections())
     {
         if (connection)
         {
+            const NetPacket replicatePacket(this);
+
             constexpr bool bReliable = true;
             NetHandler::sendPacketToConnection(replicatePacket, connection, bReliable);
         }
@@ -275,6 +428,7 @@ void ChaosJumpGameMode::evaluateScoringPlayer()
 void ChaosJumpGameMode::startGame()
 {
     bGameInProgress = true;
+    setTickInterval(0.f);
 
     if (isLocallyOwned())
     {
@@ -301,7 +455,14 @@ void ChaosJumpGameMode::reset()
     
     if (isLocallyOwned())
     {
-        setSeed(std::random_device()());
+        if (mScenario)
+        {
+            loadScenario();
+        }
+        else
+        {
+            setSeed(mSeedSequence ? (*mSeedSequence)() : std::random_device()());
+        }
     }
 
     for (ChaosJumpPlayer* player : mChaosJumpPlayers)
@@ -398,6 +559,7 @@ void ChaosJumpGameMode::tick(const float deltaTime)
     const float viewHeight = Application::getApplication().getCurrentViewLocation().y;
     clearDroppedPlatforms(viewHeight);
     clearObstaclesOutOfRange(viewHeight);
+    updateObstacleTickRates(viewHeight);
 
     const int currentChunkHeightCoord = std::abs(static_cast<int>(viewHeight) / mChunkHeight);
 
@@ -421,7 +583,7 @@ void ChaosJumpGameMode::handleKeyPressed(const SDL_Scancode scancode)
             netHandler->openInviteDialogue();
             break;
         case SDL_SCANCODE_F:
-            NetHandler::openFriendslist();
+            netHandler->openFriendslist();
             break;
         case SDL_SCANCODE_C:
             netHandler->closeSession();
@@ -437,17 +599,32 @@ void ChaosJumpGameMode::handleKeyPressed(const SDL_Scancode scancode)
     {
         switch (scancode)                    
         {                                    
+        case SDL_SCANCODE_P:
+            if (!bGameInProgress)
+            {
+                bWantsToStartGame = true;
+            }
+            break;
         case SDL_SCANCODE_H:                 
             netHandler->hostSession();       
             break;                           
         case SDL_SCANCODE_F:                 
-            NetHandler::openFriendslist();   
+            netHandler->openFriendslist();   
             break;
         default:                             
             ;                                
         }                                    
     }
 
+    if (scancode == SDL_SCANCODE_F8)
+    {
+        constexpr const char* scenarioPath = "Scenario.cjsc";
+        if (!writeScenario(scenarioPath))
+        {
+            LOG(Warning, "Couldn't write scenario to {}", scenarioPath);
+        }
+    }
+
     if (scancode == SDL_SCANCODE_ESCAPE)
     {
         endGame();
@@ -3,6 +3,7 @@
 #include <random>
 
 #include "Application.h"
+#include "Debugging/Profiler.h"
 #include "Objects/Circle.h"
 #include "Objects/Platform.h"
 #include "Objects/Polygon.h"
@@ -10,13 +11,13 @@
 #include "SDL3/SDL_stdinc.h"
 
 template<>
-std::unique_ptr<Circle> ChunkGenerator::createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize)
+TPooledPtr<Circle> ChunkGenerator::createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize)
 {
     std::uniform_int_distribution<> sizeDist(25, 75);
     std::uniform_int_distribution<> colorDist(0,SDL_MAX_UINT8);
 
     unsigned int size = sizeDist(mRandomNumberGenerator);
-    std::unique_ptr<Circle> circle = std::make_unique<Circle>(size);
+    TPooledPtr<Circle> circle = mObstaclePool.create<Circle>(size);
 
     const float r = static_cast<float>(colorDist(mRandomNumberGenerator)) / SDL_MAX_UINT8;
     const float g = static_cast<float>(colorDist(mRandomNumberGenerator)) / SDL_MAX_UINT8;
@@ -37,14 +38,14 @@ std::unique_ptr<Circle> ChunkGenerator::createRandomCollisionObject(float chunkH
 }
 
 template<>
-std::unique_ptr<Rectangle> ChunkGenerator::createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize)
+TPooledPtr<Rectangle> ChunkGenerator::createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize)
 {
     std::uniform_int_distribution<> sizeDist(50, 200);
     std::uniform_int_distribution<> colorDist(0,SDL_MAX_UINT8);
 
     unsigned int width = sizeDist(mRandomNumberGenerator);
     unsigned int height = sizeDist(mRandomNumberGenerator);
-    std::unique_ptr<Rectangle> rectangle = std::make_unique<Rectangle>(width, height);
+    TPooledPtr<Rectangle> rectangle = mObstaclePool.create<Rectangle>(width, height);
 
     const float r = static_cast<float>(colorDist(mRandomNumberGenerator)) / SDL_MAX_UINT8;
     const float g = static_cast<float>(colorDist(mRandomNumberGenerator)) / SDL_MAX_UINT8;
@@ -80,7 +81,7 @@ static Vector2 getBiggestValue(const std::vector<Vector2>& vertices)
 }
 
 template<>
-std::unique_ptr<Polygon> ChunkGenerator::createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize)
+TPooledPtr<Polygon> ChunkGenerator::createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize)
 {
     std::uniform_int_distribution<> polygonIndexDist(0, 4);
     std::uniform_int_distribution<> colorDist(0,SDL_MAX_UINT8);
@@ -98,7 +99,7 @@ std::unique_ptr<Polygon> ChunkGenerator::createRandomCollisionObject(float chunk
         return preDefinedVertices[index];
     }(polygonIndexDist(mRandomNumberGenerator));
     
-    std::unique_ptr<Polygon> polygon = std::make_unique<Polygon>(vertices);
+    TPooledPtr<Polygon> polygon = mObstaclePool.create<Polygon>(vertices);
 
     const float r = static_cast<float>(colorDist(mRandomNumberGenerator)) / SDL_MAX_UINT8;
     const float g = static_cast<float>(colorDist(mRandomNumberGenerator)) / SDL_MAX_UINT8;
@@ -122,9 +123,11 @@ std::unique_ptr<Polygon> ChunkGenerator::createRandomCollisionObject(float chunk
     return polygon;
 }
 
-void ChunkGenerator::spawnRandomObstacle(int chunkHeight, std::vector<std::unique_ptr<CollisionObject>>& outObstacles)
+void ChunkGenerator::spawnRandomObstacle(int chunkHeight, std::vector<TPooledPtr<CollisionObject>>& outObstacles)
 {
-    for (uint32_t i = 0; i < 1; ++i)
+    PROFILE_FUNCTION();
+
+    for (uint32_t i = 0; i < mObstaclePerChunkCount; ++i)
     {
         const int ObstacleType = mObstacleTypeDistribution(mRandomNumberGenerator);
 
@@ -145,7 +148,7 @@ void ChunkGenerator::spawnRandomObstacle(int chunkHeight, std::vector<std::uniqu
     }
 }
 
-ChunkGenerator::ChunkGenerator(const Vector2& inChunkSize, const uint32_t inPlatformPerChunkCount, uint32_t inSeed) : mChunkSize(inChunkSize), mPlatformPerChunkCount(inPlatformPerChunkCount), mRandomNumberGenerator(inSeed)
+ChunkGenerator::ChunkGenerator(const Vector2& inChunkSize, const uint32_t inPlatformPerChunkCount, const uint32_t inObstaclePerChunkCount, uint32_t inSeed, ObjectPool& inPlatformPool, ObjectPool& inObstaclePool) : mChunkSize(inChunkSize), mPlatformPerChunkCount(inPlatformPerChunkCount), mObstaclePerChunkCount(inObstaclePerChunkCount), mPlatformPool(inPlatformPool), mObstaclePool(inObstaclePool), mRandomNumberGenerator(inSeed)
 {
     const int halfChunkWidth = static_cast<int>(inChunkSize.x) / 2;
     const int halfChunkHeight = static_cast<int>(inChunkSize.y) / 2;
@@ -155,7 +158,7 @@ ChunkGenerator::ChunkGenerator(const Vector2& inChunkSize, const uint32_t inPlat
     mObstacleTypeDistribution = std::uniform_int_distribution<>(0, 2);
 }
 
-void ChunkGenerator::generateChunk(int chunkHeight, std::vector<std::unique_ptr<Platform>>& outPlatforms, std::vector<std::unique_ptr<CollisionObject>>& outObstacles)
+void ChunkGenerator::generateChunk(int chunkHeight, std::vector<TPooledPtr<Platform>>& outPlatforms, std::vector<TPooledPtr<CollisionObject>>& outObstacles)
 {
     mChunkGenerationHeight = std::max(mChunkGenerationHeight, chunkHeight);
 
@@ -170,7 +173,7 @@ void ChunkGenerator::generateChunk(int chunkHeight, std::vector<std::unique_ptr<
         const float g = mColorDistribution(mRandomNumberGenerator);
         const float b = mColorDistribution(mRandomNumberGenerator);
         
-        std::unique_ptr<Platform> platform = std::make_unique<Platform>();
+        TPooledPtr<Platform> platform = mPlatformPool.create<Platform>();
         platform->setLocation(position);
         platform->setColor({r, g, b});
         outPlatforms.push_back(std::move(platform));
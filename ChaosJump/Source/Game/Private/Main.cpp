@@ -1,25 +1,217 @@
+#include <charconv>
+#include <string_view>
+#include <vector>
+
 #include "Application.h"
+#include "Base/ConsoleVariable.h"
+#include "Debugging/Logger.h"
 #include "GameMode/ChaosJumpGameMode.h"
 
 constexpr const char* WINDOW_TITLE = "OpenWindow";
 constexpr int WINDOW_WIDTH = 1920;
 constexpr int WINDOW_HEIGHT = 1080;
 
+struct LaunchOptions
+{
+    bool bHeadless = false;
+    uint32_t seed = 1;
+    float deltaSeconds = 1.f / 60.f;
+    uint64_t frameCount = 3600;
+    const char* reportPath = "BenchmarkReport.json";
+
+    const char* recordReplayPath = nullptr;
+    const char* playReplayPath = nullptr;
+
+    /* Loads every round from this scenario file instead of generating chunks */
+    const char* scenarioPath = nullptr;
+    /* The world as it is when the run ends is written here */
+    const char* dumpScenarioPath = nullptr;
+
+    /* Executed before the command line ones, a missing file is skipped */
+    const char* configPath = "Config.cfg";
+    std::vector<const char*> consoleCommands = {};
+
+    /* An option was unknown, missing its value or the value didn't parse, the run must not silently fall back to the defaults */
+    bool bInvalid = false;
+};
+
+/* The whole text has to be the number, "10k" or "1/60" are rejected */
+template<typename T>
+static bool parseNumber(const std::string_view option, const std::string_view text, T& outValue)
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), outValue);
+    if (error == std::errc() && end == text.data() + text.size()) return true;
+
+    LOG(Error, "{} expects a number, got '{}'", option, text);
+    return false;
+}
+
+/* Zero frames would never end a headless run and a zero delta falls back to the measured frame time */
+template<typename T>
+static bool parsePositiveNumber(const std::string_view option, const std::string_view text, T& outValue)
+{
+    if (!parseNumber(option, text, outValue)) return false;
+    if (outValue > T(0)) return true;
+
+    LOG(Error, "{} expects a positive number, got '{}'", option, text);
+    return false;
+}
+
+/* [--headless [--seed N] [--dt SECONDS] [--frames N] [--report PATH]] [--record PATH | --replay PATH] [--scenario PATH] [--dump-scenario PATH] [--config PATH] [--cvar NAME=VALUE]... */
+static LaunchOptions parseLaunchOptions(const int argc, char* argv[])
+{
+    LaunchOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+
+        const auto takeValue = [&]() -> const char*
+        {
+            if (i + 1 < argc) return argv[++i];
+
+            LOG(Error, "{} expects a value", argument);
+            options.bInvalid = true;
+            return nullptr;
+        };
+
+        if (argument == "--headless")
+        {
+            options.bHeadless = true;
+        }
+        else if (argument == "--seed")
+        {
+            if (const char* value = takeValue())
+            {
+                options.bInvalid |= !parseNumber(argument, value, options.seed);
+            }
+        }
+        else if (argument == "--dt")
+        {
+            if (const char* value = takeValue())
+            {
+                options.bInvalid |= !parsePositiveNumber(argument, value, options.deltaSeconds);
+            }
+        }
+        else if (argument == "--frames")
+        {
+            if (const char* value = takeValue())
+            {
+                options.bInvalid |= !parsePositiveNumber(argument, value, options.frameCount);
+            }
+        }
+        else if (argument == "--report")
+        {
+            options.reportPath = takeValue();
+        }
+        else if (argument == "--record")
+        {
+            options.recordReplayPath = takeValue();
+        }
+        else if (argument == "--replay")
+        {
+            options.playReplayPath = takeValue();
+        }
+        else if (argument == "--scenario")
+        {
+            options.scenarioPath = takeValue();
+        }
+        else if (argument == "--dump-scenario")
+        {
+            options.dumpScenarioPath = takeValue();
+        }
+        else if (argument == "--config")
+        {
+            options.configPath = takeValue();
+        }
+        else if (argument == "--cvar")
+        {
+            if (const char* value = takeValue())
+            {
+                options.consoleCommands.push_back(value);
+            }
+        }
+        else
+        {
+            LOG(Error, "Unknown option '{}'", argument);
+            options.bInvalid = true;
+        }
+    }
+
+    return options;
+}
+
 int main(int argc, char *argv[])
 {
+    const LaunchOptions launchOptions = parseLaunchOptions(argc, argv);
+    if (launchOptions.bInvalid)
+    {
+        // Nothing started the logger yet, stopping it right away flushes the errors.
+        Logger::start();
+        Logger::stop();
+        return 1;
+    }
+
     ApplicationParams applicationParams;
     applicationParams.title = WINDOW_TITLE;
     applicationParams.width = WINDOW_WIDTH;
     applicationParams.height = WINDOW_HEIGHT;
-    applicationParams.framesPerSecond = 0;
-    
+    applicationParams.presentMode = PresentMode::AdaptiveVSync;
+    // Paced on top of the present mode, with vsync it only matters on displays above 240 Hz
+    applicationParams.framesPerSecond = 240;
+    applicationParams.recordReplayPath = launchOptions.recordReplayPath;
+    applicationParams.playReplayPath = launchOptions.playReplayPath;
+
+    if (launchOptions.bHeadless)
+    {
+        applicationParams.bHeadless = true;
+        applicationParams.bDrawFPS = false;
+        applicationParams.benchmarkReportPath = launchOptions.reportPath;
+
+        // A replay brings its own deltas and ends the run when it's done.
+        if (!launchOptions.playReplayPath)
+        {
+            applicationParams.fixedDeltaSeconds = launchOptions.deltaSeconds;
+            applicationParams.maxFrameCount = launchOptions.frameCount;
+        }
+    }
+    else
+    {
+        applicationParams.frameStatsPath = "FrameStats.json";
+    }
+
     Application& application = Application::initApplication(applicationParams);
+
+    // After the application applied its params, so both override them.
+    ConsoleVariable::executeConfigFile(launchOptions.configPath);
+    for (const char* command : launchOptions.consoleCommands)
+    {
+        ConsoleVariable::execute(command);
+    }
+
     std::unique_ptr gameMode = std::make_unique<ChaosJumpGameMode>();
     application.getInputRouter()->addInputReceiver(gameMode.get());
     gameMode->registerObject();
-    
+
+    if (launchOptions.scenarioPath)
+    {
+        // A benchmark of the menu would look plausible, so a broken scenario has to fail the run instead.
+        // The application is a function static, its destructor flushes the logged error on the way out.
+        if (!gameMode->startScenario(launchOptions.scenarioPath)) return 1;
+    }
+    else if (launchOptions.bHeadless && !launchOptions.playReplayPath)
+    {
+        gameMode->startLocalGame(launchOptions.seed);
+    }
+
     application.setGameMode(std::move(gameMode));
     application.run();
-    
+
+    // The game mode may have been replaced during the run, the menu one never has a world to dump.
+    if (launchOptions.dumpScenarioPath)
+    {
+        static_cast<const ChaosJumpGameMode*>(application.getGameMode())->writeScenario(launchOptions.dumpScenarioPath);
+    }
+
     return 0;
-}
\ No newline at end of file
+}
@@ -41,56 +41,32 @@ ChaosJumpPlayer::ChaosJumpPlayer() : ChaosJumpPlayer(Vector2{1, 1}, Vector2{0, 0
 {
 }
 
-ChaosJumpPlayer::ChaosJumpPlayer(const Vector2& size, const Vector2& position) : Polygon({size*Vector2{0.f,-50.f}, size*Vector2{-47.5528f,-15.4508f}, size*Vector2{-29.3893f,40.4508f}, size*Vector2{29.3893f,40.4508f}, size*Vector2{47.5528f,-15.4508f}})
+ChaosJumpPlayer::ChaosJumpPlayer(const Vector2& size, const Vector2& position) : Polygon(std::vector<Vector2>{size*Vector2{0.f,-50.f}, size*Vector2{-47.5528f,-15.4508f}, size*Vector2{-29.3893f,40.4508f}, size*Vector2{29.3893f,40.4508f}, size*Vector2{47.5528f,-15.4508f}})
 {
     setCollisionCategory(CollisionCategory::Player);
     mDampingPerSecond = {5.f, 0.f};
     setLocation(position);
 }
 
-void ChaosJumpPlayer::handleKeyPressed(const SDL_Scancode scancode)
+void ChaosJumpPlayer::handleKeyTrigger(const SDL_Scancode scancode, const float deltaTime)
 {
-    switch (scancode)
-    {
-    case SDL_SCANCODE_A:
-    case SDL_SCANCODE_LEFT:
-        mInputMovement.x -= 1;
-        break;
-    case SDL_SCANCODE_D:
-    case SDL_SCANCODE_RIGHT:
-        mInputMovement.x += 1;
-        break;
-    case SDL_SCANCODE_S:
-    case SDL_SCANCODE_DOWN:
-        mInputMovement.y = 1;
-        break;
-    default: ;
-    }
-}
-
-void ChaosJumpPlayer::handleKeyTrigger(const SDL_Scancode scancode, float deltaTime)
-{
-    //if (scancode == SDL_SCANCODE_S || scancode == SDL_SCANCODE_DOWN)
-    //{
-    //    mInputMovement.y = mVelocity.y > 0;
-    //}
-}
+    // Runs in the parallel phase, only the own velocity may change here.
+    if (!isLocallyOwned() || bDead) return;
 
-void ChaosJumpPlayer::handleKeyReleased(const SDL_Scancode scancode)
-{
     switch (scancode)
     {
     case SDL_SCANCODE_A:
     case SDL_SCANCODE_LEFT:
-        mInputMovement.x -= -1;
+        mVelocity.x -= mSpeed * deltaTime;
         break;
     case SDL_SCANCODE_D:
     case SDL_SCANCODE_RIGHT:
-        mInputMovement.x += -1;
+        mVelocity.x += mSpeed * deltaTime;
         break;
     case SDL_SCANCODE_S:
     case SDL_SCANCODE_DOWN:
-        mInputMovement.y = 0;
+        mVelocity.y += mSpeed * deltaTime;
+        break;
     default: ;
     }
 }
@@ -116,17 +92,9 @@ void ChaosJumpPlayer::tick(const float deltaTime)
 
     if (!isLocallyOwned()) return;
     if (bDead) return;
-    
-    const float deltaMovementX = mInputMovement.x * mSpeed;
-    const float deltaMovementY = mInputMovement.y * mSpeed;
-
-    const Vector2 deltaMovement  = Vector2{.x = deltaMovementX, .y = deltaMovementY} * deltaTime;
-    mVelocity += deltaMovement;
-
-    mCollisionResponseConfig[CollisionCategory::Ground] = mVelocity.y < 0.f ? CollisionResponse::Overlap : CollisionResponse::Block; 
 
+    // The input acceleration was already applied by handleKeyTrigger in the parallel phase.
     Polygon::tick(deltaTime);
-    InputReceiverInterface::tick(deltaTime);
 }
 
 std::string ChaosJumpPlayer::serialize() const  
@@ -1,8 +1,11 @@
 ﻿#pragma once
 #include <memory>
+#include <optional>
+#include <random>
 #include <vector>
 
 #include "Base/HelperDefinitions.h"
+#include "Base/ObjectPool.h"
 #include "Game/GameMode.h"
 #include "Input/InputReceiverInterface.h"
 #include "Math/Vector2.h"
@@ -11,30 +14,42 @@
 
 class ChunkGenerator;
 class ChaosJumpPlayer;
+class Scenario;
 
 DECLARE_DEFAULT_DELETER(ChunkGenerator)
+DECLARE_DEFAULT_DELETER(Scenario)
 DECLARE_DEFAULT_DELETER(ChaosJumpPlayer)
 
 class ChaosJumpGameMode : public GameMode, public TickableInterface, public InputReceiverInterface
 {
 private:
 
+    /* Moved by scenarios, seeded rounds put it back to the default */
     static Vector2 sPlayerSpawnLocation;
-    static uint32_t sPlatformsPerChunk;
 
     std::vector<ChaosJumpPlayer*> mChaosJumpPlayers;
     std::map<HSteamNetConnection, std::unique_ptr<ChaosJumpPlayer, ChaosJumpPlayerDeleter>> mPlayerMap;
     std::unique_ptr<ChunkGenerator, ChunkGeneratorDeleter> mChunkGenerator = nullptr;
+
+    /* Stays mapped for the whole game, every round reloads the world from it instead of generating chunks */
+    std::unique_ptr<Scenario, ScenarioDeleter> mScenario = nullptr;
     
     float mChunkHeight = 0.f;
 
-    std::vector<std::unique_ptr<Platform>> mPlatforms = {};
-    std::vector<std::unique_ptr<CollisionObject>> mObstacles = {};
+    /* Declared before the objects living in them so they are destroyed last */
+    ObjectPool mPlatformPool;
+    ObjectPool mObstaclePool;
+
+    std::vector<TPooledPtr<Platform>> mPlatforms = {};
+    std::vector<TPooledPtr<CollisionObject>> mObstacles = {};
 
     float mGameTime = 0.f;
 
     float mEndPhaseSeconds = -1.f;
 
+    /* Seeds the rounds of a deterministic run instead of std::random_device */
+    std::optional<std::minstd_rand> mSeedSequence;
+
     struct //Replicated Properties
     {
         bool bWantsToStartGame = false;
@@ -49,10 +64,14 @@ private:
 protected:
 
     void setSeed(uint32_t inSeed);
+    void loadScenario();
 
     void clearDroppedPlatforms(float currentHeight);
     void clearObstaclesOutOfRange(float currentHeight);
 
+    /* Obstacles more than half a chunk outside the view tick every game.FarObstacleTickFrames frames */
+    void updateObstacleTickRates(float viewHeight);
+
     void drawMenuDisplayText() const;
     void drawGameHUD(float deltaTime);
 
@@ -67,8 +86,18 @@ public:
     void handleNetworkError() override;
     void addPlayer(Player* player) override;
     void removePlayer(Player* player) override;
+    void appendObjectCounts(std::vector<ObjectCount>& outCounts) const override;
     //~ End GameMode Interface
 
+    /* Starts an offline game on the next tick, every round is seeded from seed so runs can be reproduced */
+    void startLocalGame(uint32_t seed);
+
+    /* Starts an offline game on the next tick whose rounds all load the world from the scenario file */
+    bool startScenario(const char* path);
+
+    /* Writes the current platforms, obstacles and player spawn as a scenario file */
+    bool writeScenario(const char* path) const;
+
 protected:
 
     void evaluateScoringPlayer();
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <random>
 
+#include "Base/ObjectPool.h"
 #include "Math/Vector2.h"
 
 class Platform;
@@ -16,6 +17,10 @@ private:
 
     int mChunkGenerationHeight = 0;
     uint32_t mPlatformPerChunkCount = 8;
+    uint32_t mObstaclePerChunkCount = 1;
+
+    ObjectPool& mPlatformPool;
+    ObjectPool& mObstaclePool;
 
     struct
     {
@@ -28,16 +33,17 @@ private:
 
 protected:
 
-    void spawnRandomObstacle(int chunkHeight, std::vector<std::unique_ptr<CollisionObject>>& outObstacles);
+    void spawnRandomObstacle(int chunkHeight, std::vector<TPooledPtr<CollisionObject>>& outObstacles);
 
     template<class ObjectType>
-    std::unique_ptr<ObjectType> createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize);
+    TPooledPtr<ObjectType> createRandomCollisionObject(float chunkHeight, const Vector2& chunkSize);
     
 public:
 
-    ChunkGenerator(const Vector2& inChunkSize, uint32_t inPlatformPerChunkCount, uint32_t inSeed);
+    /* Platforms and obstacles are created in the pools, which have to outlive them */
+    ChunkGenerator(const Vector2& inChunkSize, uint32_t inPlatformPerChunkCount, uint32_t inObstaclePerChunkCount, uint32_t inSeed, ObjectPool& inPlatformPool, ObjectPool& inObstaclePool);
 
-    void generateChunk(int chunkHeight, std::vector<std::unique_ptr<Platform>>& outPlatforms, std::vector<std::unique_ptr<CollisionObject>>& outObstacles);
+    void generateChunk(int chunkHeight, std::vector<TPooledPtr<Platform>>& outPlatforms, std::vector<TPooledPtr<CollisionObject>>& outObstacles);
     int getChunkGenerationHeight() const { return mChunkGenerationHeight; }
 
 };
@@ -19,8 +19,6 @@ private:
 
     float mSpeed = 5000.f;
 
-    SDL_FPoint mInputMovement = { 0, 0 };
-
     std::shared_ptr<Camera> mCamera = nullptr;
 
     float mReachedHeight = 0.f;
@@ -38,9 +36,7 @@ public:
     ChaosJumpPlayer();
     ChaosJumpPlayer(const Vector2& size, const Vector2& position);
     
-    void handleKeyPressed(SDL_Scancode scancode) override;
     void handleKeyTrigger(SDL_Scancode scancode, float deltaTime) override;
-    void handleKeyReleased(SDL_Scancode scancode) override;
 
     float getReachedHeight() const { return mReachedHeight; }
 